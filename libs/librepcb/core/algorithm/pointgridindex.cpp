@@ -0,0 +1,139 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "pointgridindex.h"
+
+#include "../utils/clipperhelpers.h"
+
+#include <QtCore>
+
+#include <algorithm>
+#include <cmath>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+PointGridIndex::PointGridIndex(const QVector<Point>& points) noexcept
+  : mPoints(),
+    mLeft(0),
+    mTop(0),
+    mCellSize(1),
+    mColumns(0),
+    mRows(0),
+    mCells() {
+  if (points.isEmpty()) {
+    return;
+  }
+
+  // Determine the bounds of all points.
+  mPoints.reserve(points.count());
+  foreach (const Point& point, points) {
+    mPoints.append(ClipperHelpers::convert(point));
+  }
+  const ClipperLib::IntRect bounds =
+      ClipperHelpers::getBounds({mPoints.toStdVector()});
+  mLeft = bounds.left;
+  mTop = bounds.top;
+
+  // Choose the cell size to get roughly one point per cell, but limit the
+  // number of cells if all points are located on a (nearly) straight line.
+  const qreal width = static_cast<qreal>(bounds.right - bounds.left) + 1;
+  const qreal height = static_cast<qreal>(bounds.bottom - bounds.top) + 1;
+  const qreal count = mPoints.count();
+  const qreal cellSize = std::max(std::sqrt(width * height / count),
+                                  std::max(width, height) / count);
+  mCellSize = std::max(static_cast<ClipperLib::cInt>(std::ceil(cellSize)),
+                       static_cast<ClipperLib::cInt>(1));
+  mColumns = static_cast<int>((bounds.right - bounds.left) / mCellSize) + 1;
+  mRows = static_cast<int>((bounds.bottom - bounds.top) / mCellSize) + 1;
+
+  // Sort points into cells.
+  mCells.resize(mColumns * mRows);
+  for (int i = 0; i < mPoints.count(); ++i) {
+    const int column = static_cast<int>((mPoints.at(i).X - mLeft) / mCellSize);
+    const int row = static_cast<int>((mPoints.at(i).Y - mTop) / mCellSize);
+    mCells[row * mColumns + column].append(i);
+  }
+}
+
+PointGridIndex::~PointGridIndex() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+QVector<int> PointGridIndex::findPointsInArea(const Path& area) const
+    noexcept {
+  QVector<int> result;
+  if (mPoints.isEmpty()) {
+    return result;
+  }
+
+  const ClipperLib::Path polygon =
+      ClipperHelpers::convert(area, PositiveLength(5000));
+  const ClipperLib::IntRect bounds = ClipperHelpers::getBounds({polygon});
+  if (bounds.left > bounds.right) {
+    return result;  // empty area
+  }
+
+  // Determine the range of cells overlapping the bounding box of the area.
+  auto toCell = [this](ClipperLib::cInt value, ClipperLib::cInt origin,
+                       int count) {
+    const ClipperLib::cInt cell = (value - origin) / mCellSize;
+    return static_cast<int>(qBound(static_cast<ClipperLib::cInt>(-1), cell,
+                                   static_cast<ClipperLib::cInt>(count)));
+  };
+  const int firstColumn = std::max(toCell(bounds.left, mLeft, mColumns), 0);
+  const int lastColumn =
+      std::min(toCell(bounds.right, mLeft, mColumns), mColumns - 1);
+  const int firstRow = std::max(toCell(bounds.top, mTop, mRows), 0);
+  const int lastRow = std::min(toCell(bounds.bottom, mTop, mRows), mRows - 1);
+
+  // Test all points of these cells.
+  for (int row = firstRow; row <= lastRow; ++row) {
+    for (int column = firstColumn; column <= lastColumn; ++column) {
+      foreach (int index, mCells.at(row * mColumns + column)) {
+        const ClipperLib::IntPoint& p = mPoints.at(index);
+        if ((p.X >= bounds.left) && (p.X <= bounds.right) &&
+            (p.Y >= bounds.top) && (p.Y <= bounds.bottom) &&
+            (ClipperLib::PointInPolygon(p, polygon) != 0)) {
+          result.append(index);
+        }
+      }
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,96 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_POINTGRIDINDEX_H
+#define LIBREPCB_CORE_POINTGRIDINDEX_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../types/point.h"
+
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class Path;
+
+/*******************************************************************************
+ *  Class PointGridIndex
+ ******************************************************************************/
+
+/**
+ * @brief Spatial index to quickly find points located within polygons
+ *
+ * The points are sorted into a uniform grid with roughly one point per cell.
+ * A query then only tests the points in the cells overlapping the bounding
+ * box of the polygon, using integer coordinates.
+ */
+class PointGridIndex final {
+public:
+  // Constructors / Destructor
+  PointGridIndex() = delete;
+  PointGridIndex(const PointGridIndex& other) = delete;
+
+  /**
+   * @brief Constructor
+   *
+   * @param points  The points to index. The results of queries are indices
+   *                into this list.
+   */
+  explicit PointGridIndex(const QVector<Point>& points) noexcept;
+  ~PointGridIndex() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Find all points located within an area
+   *
+   * @param area    A closed polygon. Arcs are approximated by line segments.
+   *
+   * @return Indices of all points located within the area or on its outline,
+   *         in ascending order.
+   */
+  QVector<int> findPointsInArea(const Path& area) const noexcept;
+
+  // Operator Overloadings
+  PointGridIndex& operator=(const PointGridIndex& rhs) = delete;
+
+private:  // Data
+  QVector<ClipperLib::IntPoint> mPoints;
+  ClipperLib::cInt mLeft;
+  ClipperLib::cInt mTop;
+  ClipperLib::cInt mCellSize;
+  int mColumns;
+  int mRows;
+  QVector<QVector<int>> mCells;  ///< Point indices, row by row
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -25,6 +25,7 @@
 #include "../fileio/fileutils.h"
 #include "../types/point.h"
 #include "../utils/toolbox.h"
+#include "gerberstreamwriter.h"
 
 #include <QtCore>
 
@@ -100,39 +101,53 @@ void ExcellonGenerator::drill(const NonEmptyPath& path,
 
 void ExcellonGenerator::generate() {
   mOutput.clear();
-  printHeader();
-  printDrills();
-  printFooter();
+  QBuffer buffer(&mOutput);
+  buffer.open(QIODevice::WriteOnly);
+  generate(buffer);  // can throw
+}
+
+void ExcellonGenerator::generate(QIODevice& device) {
+  GerberStreamWriter writer(device, false);
+  printHeader(writer);  // can throw
+  printDrills(writer);  // can throw
+  printFooter(writer);  // can throw
+  writer.flush();  // can throw
+}
+
+void ExcellonGenerator::generateToFile(const FilePath& filepath) {
+  FileUtils::writeFile(filepath, [this](QIODevice& device) {
+    generate(device);  // can throw
+  });
 }
 
 void ExcellonGenerator::saveToFile(const FilePath& filepath) const {
-  FileUtils::writeFile(filepath, mOutput.toLatin1());  // can throw
+  FileUtils::writeFile(filepath, mOutput);  // can throw
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-void ExcellonGenerator::printHeader() noexcept {
-  mOutput.append("M48\n");  // Beginning of Part Program Header
+void ExcellonGenerator::printHeader(GerberStreamWriter& writer) {
+  writer.write("M48\n");  // Beginning of Part Program Header
 
   // Add file attributes.
   foreach (const GerberAttribute& a, mFileAttributes) {
-    mOutput.append(a.toExcellonString());
+    writer.write(a.toExcellonString().toLatin1());
   }
 
-  mOutput.append("FMAT,2\n");  // Use Format 2 commands
-  mOutput.append("METRIC,TZ\n");  // Metric Format, Trailing Zeros Mode
+  writer.write("FMAT,2\n");  // Use Format 2 commands
+  writer.write("METRIC,TZ\n");  // Metric Format, Trailing Zeros Mode
 
-  printToolList();
+  printToolList(writer);
 
-  mOutput.append("%\n");  // Beginning of Pattern
-  mOutput.append("G90\n");  // Absolute Mode
-  mOutput.append("G05\n");  // Drill Mode
-  mOutput.append("M71\n");  // Metric Measuring Mode
+  writer.write("%\n");  // Beginning of Pattern
+  writer.write("G90\n");  // Absolute Mode
+  writer.write("G05\n");  // Drill Mode
+  writer.write("M71\n");  // Metric Measuring Mode
 }
 
-void ExcellonGenerator::printToolList() noexcept {
+void ExcellonGenerator::printToolList(GerberStreamWriter& writer) {
   const auto tools = mDrillList.uniqueKeys();
   for (int i = 0; i < tools.count(); ++i) {
     bool plated = std::get<1>(tools.at(i));
@@ -140,41 +155,51 @@ void ExcellonGenerator::printToolList() noexcept {
     GerberAttribute apertureFunctionAttribute = (mPlating == Plating::Mixed)
         ? GerberAttribute::apertureFunctionMixedPlatingDrill(plated, function)
         : GerberAttribute::apertureFunction(function);
-    mOutput.append(apertureFunctionAttribute.toExcellonString());
+    writer.write(apertureFunctionAttribute.toExcellonString().toLatin1());
 
     Length dia = std::get<0>(tools.at(i));
-    mOutput.append(QString("T%1C%2\n").arg(i + 1).arg(dia.toMmString()));
+    writer.write("T");
+    writer.writeInteger(i + 1);
+    writer.write("C");
+    writer.writeDecimalFixedPoint(dia.toNm(), 6);
+    writer.write("\n");
   }
 }
 
-void ExcellonGenerator::printDrills() {
-  for (int i = 0; i < mDrillList.uniqueKeys().count(); ++i) {
-    mOutput.append(QString("T%1\n").arg(i + 1));  // Select Tool
-    auto tool = mDrillList.uniqueKeys().value(i);
-    foreach (const NonEmptyPath& path, mDrillList.values(tool)) {
-      printPath(path);
+void ExcellonGenerator::printDrills(GerberStreamWriter& writer) {
+  const auto tools = mDrillList.uniqueKeys();
+  for (int i = 0; i < tools.count(); ++i) {
+    // Select Tool
+    writer.write("T");
+    writer.writeInteger(i + 1);
+    writer.write("\n");
+    foreach (const NonEmptyPath& path, mDrillList.values(tools.at(i))) {
+      printPath(writer, path);
     }
   }
 }
 
-void ExcellonGenerator::printPath(const NonEmptyPath& path) {
+void ExcellonGenerator::printPath(GerberStreamWriter& writer,
+                                  const NonEmptyPath& path) {
   if (path->getVertices().count() < 1) {
     qCritical() << "Empty path in Excellon export ignored!";
   } else if (path->getVertices().count() == 1) {
-    printDrill(path->getVertices().first().getPos());
+    printDrill(writer, path->getVertices().first().getPos());
   } else if (mUseG85Slots) {
-    printSlot(path);
+    printSlot(writer, path);
   } else {
-    printRout(path);
+    printRout(writer, path);
   }
 }
 
-void ExcellonGenerator::printDrill(const Point& pos) noexcept {
-  mOutput.append(QString("X%1Y%2\n")
-                     .arg(pos.getX().toMmString(), pos.getY().toMmString()));
+void ExcellonGenerator::printDrill(GerberStreamWriter& writer,
+                                   const Point& pos) {
+  printCoordinates(writer, pos);
+  writer.write("\n");
 }
 
-void ExcellonGenerator::printSlot(const NonEmptyPath& path) {
+void ExcellonGenerator::printSlot(GerberStreamWriter& writer,
+                                  const NonEmptyPath& path) {
   for (int i = 1; i < path->getVertices().count(); ++i) {
     const Vertex& v0 = path->getVertices().at(i - 1);
     const Vertex& v1 = path->getVertices().at(i);
@@ -184,61 +209,78 @@ void ExcellonGenerator::printSlot(const NonEmptyPath& path) {
           tr("Using the G85 slot command is not possible for curved slots. "
              "Either remove curved slots or disable the G85 export option."));
     }
-    mOutput.append(QString("X%1Y%2G85X%3Y%4\n")
-                       .arg(v0.getPos().getX().toMmString(),
-                            v0.getPos().getY().toMmString(),
-                            v1.getPos().getX().toMmString(),
-                            v1.getPos().getY().toMmString()));
+    printCoordinates(writer, v0.getPos());
+    writer.write("G85");
+    printCoordinates(writer, v1.getPos());
+    writer.write("\n");
   }
 }
 
-void ExcellonGenerator::printRout(const NonEmptyPath& path) noexcept {
-  printMoveTo(path->getVertices().first().getPos());
-  mOutput.append("M15\n");  // Z Axis Route Position
+void ExcellonGenerator::printRout(GerberStreamWriter& writer,
+                                  const NonEmptyPath& path) {
+  printMoveTo(writer, path->getVertices().first().getPos());
+  writer.write("M15\n");  // Z Axis Route Position
   for (int i = 1; i < path->getVertices().count(); ++i) {
     const Vertex& v0 = path->getVertices().at(i - 1);
     const Vertex& v1 = path->getVertices().at(i);
     if (v0.getAngle() == 0) {
-      printLinearInterpolation(v1.getPos());
+      printLinearInterpolation(writer, v1.getPos());
     } else if (v0.getAngle().abs() > Angle::deg180()) {
       // Split arc as recommended in the XNC format specification from Ucamco.
       const Angle halfAngle = v0.getAngle() / 2;
       const Point center =
           Toolbox::arcCenter(v0.getPos(), v1.getPos(), v0.getAngle());
       const Point middlePos = v0.getPos().rotated(halfAngle, center);
-      printCircularInterpolation(v0.getPos(), middlePos, halfAngle);
-      printCircularInterpolation(middlePos, v1.getPos(),
+      printCircularInterpolation(writer, v0.getPos(), middlePos, halfAngle);
+      printCircularInterpolation(writer, middlePos, v1.getPos(),
                                  v0.getAngle() - halfAngle);
     } else {
-      printCircularInterpolation(v0.getPos(), v1.getPos(), v0.getAngle());
+      printCircularInterpolation(writer, v0.getPos(), v1.getPos(),
+                                 v0.getAngle());
     }
   }
-  mOutput.append("M16\n");  // Retract With Clamping
-  mOutput.append("G05\n");  // Drill Mode
+  writer.write("M16\n");  // Retract With Clamping
+  writer.write("G05\n");  // Drill Mode
 }
 
-void ExcellonGenerator::printMoveTo(const Point& pos) noexcept {
-  mOutput.append(QString("G00X%1Y%2\n")
-                     .arg(pos.getX().toMmString(), pos.getY().toMmString()));
+void ExcellonGenerator::printMoveTo(GerberStreamWriter& writer,
+                                    const Point& pos) {
+  writer.write("G00");
+  printCoordinates(writer, pos);
+  writer.write("\n");
 }
 
-void ExcellonGenerator::printLinearInterpolation(const Point& pos) noexcept {
-  mOutput.append(QString("G01X%1Y%2\n")
-                     .arg(pos.getX().toMmString(), pos.getY().toMmString()));
+void ExcellonGenerator::printLinearInterpolation(GerberStreamWriter& writer,
+                                                 const Point& pos) {
+  writer.write("G01");
+  printCoordinates(writer, pos);
+  writer.write("\n");
 }
 
-void ExcellonGenerator::printCircularInterpolation(
-    const Point& from, const Point& to, const Angle& angle) noexcept {
-  const QString cmd = (angle < 0) ? "G02" : "G03";
+void ExcellonGenerator::printCircularInterpolation(GerberStreamWriter& writer,
+                                                   const Point& from,
+                                                   const Point& to,
+                                                   const Angle& angle) {
   const Length radius = Toolbox::arcRadius(from, to, angle).abs();
-  mOutput.append(QString("%1X%2Y%3A%4\n")
-                     .arg(cmd, to.getX().toMmString(), to.getY().toMmString(),
-                          radius.toMmString()));
+  writer.write((angle < 0) ? "G02" : "G03");
+  printCoordinates(writer, to);
+  writer.write("A");
+  writer.writeDecimalFixedPoint(radius.toNm(), 6);
+  writer.write("\n");
+}
+
+void ExcellonGenerator::printCoordinates(GerberStreamWriter& writer,
+                                         const Point& pos) {
+  // Same format as Length::toMmString().
+  writer.write("X");
+  writer.writeDecimalFixedPoint(pos.getX().toNm(), 6);
+  writer.write("Y");
+  writer.writeDecimalFixedPoint(pos.getY().toNm(), 6);
 }
 
-void ExcellonGenerator::printFooter() noexcept {
-  mOutput.append("T0\n");
-  mOutput.append("M30\n");  // End of Program Rewind
+void ExcellonGenerator::printFooter(GerberStreamWriter& writer) {
+  writer.write("T0\n");
+  writer.write("M30\n");  // End of Program Rewind
 }
 
 /*******************************************************************************
@@ -35,6 +35,7 @@
  ******************************************************************************/
 namespace librepcb {
 
+class GerberStreamWriter;
 class Point;
 
 /*******************************************************************************
@@ -64,7 +65,7 @@ public:
   void setUseG85Slots(bool use) noexcept { mUseG85Slots = use; }
 
   // Getters
-  const QString& toStr() const noexcept { return mOutput; }
+  QString toStr() const noexcept { return QString::fromLatin1(mOutput); }
 
   // General Methods
   void drill(const Point& pos, const PositiveLength& dia, bool plated,
@@ -72,24 +73,28 @@ public:
   void drill(const NonEmptyPath& path, const PositiveLength& dia, bool plated,
              Function function) noexcept;
   void generate();
+  void generate(QIODevice& device);
+  void generateToFile(const FilePath& filepath);
   void saveToFile(const FilePath& filepath) const;
 
   // Operator Overloadings
   ExcellonGenerator& operator=(const ExcellonGenerator& rhs) = delete;
 
 private:
-  void printHeader() noexcept;
-  void printToolList() noexcept;
-  void printDrills();
-  void printPath(const NonEmptyPath& path);
-  void printDrill(const Point& pos) noexcept;
-  void printSlot(const NonEmptyPath& path);
-  void printRout(const NonEmptyPath& path) noexcept;
-  void printMoveTo(const Point& pos) noexcept;
-  void printLinearInterpolation(const Point& pos) noexcept;
-  void printCircularInterpolation(const Point& from, const Point& to,
-                                  const Angle& angle) noexcept;
-  void printFooter() noexcept;
+  void printHeader(GerberStreamWriter& writer);
+  void printToolList(GerberStreamWriter& writer);
+  void printDrills(GerberStreamWriter& writer);
+  void printPath(GerberStreamWriter& writer, const NonEmptyPath& path);
+  void printDrill(GerberStreamWriter& writer, const Point& pos);
+  void printSlot(GerberStreamWriter& writer, const NonEmptyPath& path);
+  void printRout(GerberStreamWriter& writer, const NonEmptyPath& path);
+  void printMoveTo(GerberStreamWriter& writer, const Point& pos);
+  void printLinearInterpolation(GerberStreamWriter& writer, const Point& pos);
+  void printCircularInterpolation(GerberStreamWriter& writer,
+                                  const Point& from, const Point& to,
+                                  const Angle& angle);
+  void printCoordinates(GerberStreamWriter& writer, const Point& pos);
+  void printFooter(GerberStreamWriter& writer);
 
   // Types
   typedef std::tuple<Length, bool, Function> Tool;
@@ -102,7 +107,7 @@ private:
   bool mUseG85Slots;
 
   // Excellon Data
-  QString mOutput;
+  QByteArray mOutput;  ///< Only used by #generate() without arguments
   QMultiMap<Tool, NonEmptyPath> mDrillList;
 };
 
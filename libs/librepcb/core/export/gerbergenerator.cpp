@@ -29,6 +29,7 @@
 #include "gerberaperturelist.h"
 #include "gerberattribute.h"
 #include "gerberattributewriter.h"
+#include "gerberstreamwriter.h"
 
 #include <QtCore>
 
@@ -393,17 +394,31 @@ void GerberGenerator::flashComponentPin(
 
 void GerberGenerator::generate() {
   mOutput.clear();
-  printHeader();
-  printApertureList();
-  printContent();
-  printFooter();
+  QBuffer buffer(&mOutput);
+  buffer.open(QIODevice::WriteOnly);
+  generate(buffer);  // can throw
 }
 
-void GerberGenerator::saveToFile(const FilePath& filepath) const {
+void GerberGenerator::generate(QIODevice& device) {
   // Note: Although we save it as UTF-8, usually it will still contain only
   // ASCII characters for maximum compatibility with legacy crappy readers.
   // Unicode is only required when exporting Gerber X3 assembly attributes.
-  FileUtils::writeFile(filepath, mOutput.toUtf8());  // can throw
+  GerberStreamWriter writer(device, true);
+  printHeader(writer);  // can throw
+  printApertureList(writer);  // can throw
+  printContent(writer);  // can throw
+  printFooter(writer);  // can throw
+  writer.flush();  // can throw
+}
+
+void GerberGenerator::generateToFile(const FilePath& filepath) {
+  FileUtils::writeFile(filepath, [this](QIODevice& device) {
+    generate(device);  // can throw
+  });
+}
+
+void GerberGenerator::saveToFile(const FilePath& filepath) const {
+  FileUtils::writeFile(filepath, mOutput);  // can throw
 }
 
 /*******************************************************************************
@@ -451,12 +466,14 @@ void GerberGenerator::setCurrentAttributes(
   if (componentRotation) {
     attributes.append(GerberAttribute::componentRotation(*componentRotation));
   }
-  mContent.append(mAttributeWriter->setAttributes(attributes));
+  mContent.append(mAttributeWriter->setAttributes(attributes).toUtf8());
 }
 
 void GerberGenerator::setCurrentAperture(int number) noexcept {
   if (number != mCurrentApertureNumber) {
-    mContent.append(QString("D%1*\n").arg(number));
+    mContent.append('D');
+    GerberStreamWriter::appendInteger(mContent, number);
+    mContent.append("*\n");
     mCurrentApertureNumber = number;
   }
 }
@@ -482,22 +499,25 @@ void GerberGenerator::switchToCircularCcwInterpolationModeG03() noexcept {
 }
 
 void GerberGenerator::moveToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D02*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendPosition(pos);
+  mContent.append("D02*\n");
 }
 
 void GerberGenerator::linearInterpolateToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D01*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendPosition(pos);
+  mContent.append("D01*\n");
 }
 
 void GerberGenerator::circularInterpolateToPosition(const Point& start,
                                                     const Point& center,
                                                     const Point& end) noexcept {
   Point diff = center - start;
-  mContent.append(QString("X%1Y%2I%3J%4D01*\n")
-                      .arg(end.getX().toNmString(), end.getY().toNmString(),
-                           diff.getX().toNmString(), diff.getY().toNmString()));
+  appendPosition(end);
+  mContent.append('I');
+  GerberStreamWriter::appendInteger(mContent, diff.getX().toNm());
+  mContent.append('J');
+  GerberStreamWriter::appendInteger(mContent, diff.getY().toNm());
+  mContent.append("D01*\n");
 }
 
 void GerberGenerator::interpolateBetween(const Vertex& from,
@@ -520,16 +540,24 @@ void GerberGenerator::interpolateBetween(const Vertex& from,
 }
 
 void GerberGenerator::flashAtPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D03*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendPosition(pos);
+  mContent.append("D03*\n");
+}
+
+void GerberGenerator::appendPosition(const Point& pos) noexcept {
+  // Coordinate format "6.6" allows us to directly use nanometers.
+  mContent.append('X');
+  GerberStreamWriter::appendInteger(mContent, pos.getX().toNm());
+  mContent.append('Y');
+  GerberStreamWriter::appendInteger(mContent, pos.getY().toNm());
 }
 
-void GerberGenerator::printHeader() noexcept {
-  mOutput.append("G04 --- HEADER BEGIN --- *\n");
+void GerberGenerator::printHeader(GerberStreamWriter& writer) {
+  writer.write("G04 --- HEADER BEGIN --- *\n");
 
   // Add file attributes.
   foreach (const GerberAttribute& a, mFileAttributes) {
-    mOutput.append(a.toGerberString());
+    writer.write(a.toGerberString().toUtf8());
   }
 
   // coordinate format specification:
@@ -537,49 +565,41 @@ void GerberGenerator::printHeader() noexcept {
   //  - absolute coordinates
   //  - coordiante format "6.6" --> allows us to directly use LengthBase_t
   //  (nanometers)!
-  mOutput.append("%FSLAX66Y66*%\n");
+  writer.write("%FSLAX66Y66*%\n");
 
   // set unit to millimeters
-  mOutput.append("%MOMM*%\n");
+  writer.write("%MOMM*%\n");
 
   // start linear interpolation mode
-  mOutput.append("G01*\n");
+  writer.write("G01*\n");
 
   // Use multi quadrant arc mode (single quadrant mode is buggy in some CAM
   // software and is now deprecated in the current Gerber specs).
   // See https://github.com/LibrePCB/LibrePCB/issues/247.
-  mOutput.append("G75*\n");
+  writer.write("G75*\n");
 
-  mOutput.append("G04 --- HEADER END --- *\n");
+  writer.write("G04 --- HEADER END --- *\n");
 }
 
-void GerberGenerator::printApertureList() noexcept {
-  mOutput.append("G04 --- APERTURE LIST BEGIN --- *\n");
-  mOutput.append(mApertureList->generateString());
-  mOutput.append("G04 --- APERTURE LIST END --- *\n");
+void GerberGenerator::printApertureList(GerberStreamWriter& writer) {
+  writer.write("G04 --- APERTURE LIST BEGIN --- *\n");
+  writer.write(mApertureList->generateString().toUtf8());
+  writer.write("G04 --- APERTURE LIST END --- *\n");
 }
 
-void GerberGenerator::printContent() noexcept {
-  mOutput.append("G04 --- BOARD BEGIN --- *\n");
-  mOutput.append(mContent);
-  mOutput.append("G04 --- BOARD END --- *\n");
+void GerberGenerator::printContent(GerberStreamWriter& writer) {
+  writer.write("G04 --- BOARD BEGIN --- *\n");
+  writer.write(mContent);
+  writer.write("G04 --- BOARD END --- *\n");
 }
 
-void GerberGenerator::printFooter() noexcept {
+void GerberGenerator::printFooter(GerberStreamWriter& writer) {
   // MD5 checksum over content
-  mOutput.append(
-      GerberAttribute::fileMd5(calcOutputMd5Checksum()).toGerberString());
+  const QString md5 = QString::fromLatin1(writer.getMd5Checksum());
+  writer.write(GerberAttribute::fileMd5(md5).toGerberString().toUtf8());
 
   // end of file
-  mOutput.append("M02*\n");
-}
-
-QString GerberGenerator::calcOutputMd5Checksum() const noexcept {
-  // according to the RS-274C standard, linebreaks are not included in the
-  // checksum
-  QString data = QString(mOutput).remove(QChar('\n'));
-  return QString(
-      QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+  writer.write("M02*\n");
 }
 
 /*******************************************************************************
@@ -38,6 +38,7 @@ namespace librepcb {
 
 class Angle;
 class GerberAttributeWriter;
+class GerberStreamWriter;
 class Path;
 class Point;
 
@@ -67,7 +68,7 @@ public:
   ~GerberGenerator() noexcept;
 
   // Getters
-  const QString& toStr() const noexcept { return mOutput; }
+  QString toStr() const noexcept { return QString::fromUtf8(mOutput); }
 
   // Plot Methods
   void setFileFunctionOutlines(bool plated) noexcept;
@@ -130,6 +131,8 @@ public:
 
   // General Methods
   void generate();
+  void generate(QIODevice& device);
+  void generateToFile(const FilePath& filepath);
   void saveToFile(const FilePath& filepath) const;
 
   // Operator Overloadings
@@ -157,18 +160,18 @@ private:
                                      const Point& end) noexcept;
   void interpolateBetween(const Vertex& from, const Vertex& to) noexcept;
   void flashAtPosition(const Point& pos) noexcept;
-  void printHeader() noexcept;
-  void printApertureList() noexcept;
-  void printContent() noexcept;
-  void printFooter() noexcept;
-  QString calcOutputMd5Checksum() const noexcept;
+  void appendPosition(const Point& pos) noexcept;
+  void printHeader(GerberStreamWriter& writer);
+  void printApertureList(GerberStreamWriter& writer);
+  void printContent(GerberStreamWriter& writer);
+  void printFooter(GerberStreamWriter& writer);
 
   // Metadata
   QVector<GerberAttribute> mFileAttributes;
 
   // Gerber Data
-  QString mOutput;
-  QString mContent;
+  QByteArray mOutput;  ///< Only used by #generate() without arguments
+  QByteArray mContent;  ///< UTF-8 encoded board content
   QScopedPointer<GerberAttributeWriter> mAttributeWriter;
   QScopedPointer<GerberApertureList> mApertureList;
   int mCurrentApertureNumber;
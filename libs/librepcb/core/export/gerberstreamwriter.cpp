@@ -0,0 +1,190 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "gerberstreamwriter.h"
+
+#include "../exceptions.h"
+
+#include <QtCore>
+
+#include <algorithm>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constants
+ ******************************************************************************/
+
+static const int sBufferSize = 64 * 1024;
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+GerberStreamWriter::GerberStreamWriter(QIODevice& device,
+                                       bool calcMd5Checksum) noexcept
+  : mDevice(device),
+    mBuffer(),
+    mHash(calcMd5Checksum ? new QCryptographicHash(QCryptographicHash::Md5)
+                          : nullptr) {
+  mBuffer.reserve(sBufferSize);
+}
+
+GerberStreamWriter::~GerberStreamWriter() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void GerberStreamWriter::write(const QByteArray& data) {
+  if (data.size() >= sBufferSize) {
+    // Large blocks are written directly to avoid copying them.
+    flush();  // can throw
+    writeToDevice(data);  // can throw
+  } else {
+    reserve(data.size());  // can throw
+    mBuffer.append(data);
+  }
+}
+
+void GerberStreamWriter::write(const char* data) {
+  const int size = static_cast<int>(qstrlen(data));
+  reserve(size);  // can throw
+  mBuffer.append(data, size);
+}
+
+void GerberStreamWriter::writeInteger(qint64 value) {
+  reserve(20);  // can throw
+  appendInteger(mBuffer, value);
+}
+
+void GerberStreamWriter::writeDecimalFixedPoint(qint64 value, int pointPos) {
+  reserve(40);  // can throw
+  appendDecimalFixedPoint(mBuffer, value, pointPos);
+}
+
+void GerberStreamWriter::flush() {
+  if (!mBuffer.isEmpty()) {
+    writeToDevice(mBuffer);  // can throw
+    mBuffer.resize(0);  // Unlike clear(), this keeps the reserved memory.
+  }
+}
+
+QByteArray GerberStreamWriter::getMd5Checksum() {
+  if (!mHash) {
+    throw LogicError(__FILE__, __LINE__, "MD5 checksum is not enabled.");
+  }
+  flush();  // can throw
+  return mHash->result().toHex();
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+void GerberStreamWriter::appendInteger(QByteArray& out, qint64 value) noexcept {
+  char buffer[24];
+  char* const end = buffer + sizeof(buffer);
+  char* p = end;
+  quint64 abs = (value < 0) ? (0 - static_cast<quint64>(value))
+                            : static_cast<quint64>(value);
+  do {
+    *(--p) = static_cast<char>('0' + (abs % 10));
+    abs /= 10;
+  } while (abs > 0);
+  if (value < 0) {
+    *(--p) = '-';
+  }
+  out.append(p, static_cast<int>(end - p));
+}
+
+void GerberStreamWriter::appendDecimalFixedPoint(QByteArray& out, qint64 value,
+                                                 int pointPos) noexcept {
+  Q_ASSERT((pointPos > 0) && (pointPos < 19));
+  quint64 divisor = 1;
+  for (int i = 0; i < pointPos; ++i) {
+    divisor *= 10;
+  }
+  const quint64 abs = (value < 0) ? (0 - static_cast<quint64>(value))
+                                  : static_cast<quint64>(value);
+  if (value < 0) {
+    out.append('-');
+  }
+  appendInteger(out, static_cast<qint64>(abs / divisor));
+  out.append('.');
+
+  // Fractional part with leading zeros, but without trailing zeros (at least
+  // one digit is always kept).
+  char buffer[20];
+  quint64 fraction = abs % divisor;
+  int length = pointPos;
+  for (int i = pointPos - 1; i >= 0; --i) {
+    buffer[i] = static_cast<char>('0' + (fraction % 10));
+    fraction /= 10;
+  }
+  while ((length > 1) && (buffer[length - 1] == '0')) {
+    --length;
+  }
+  out.append(buffer, length);
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void GerberStreamWriter::reserve(int size) {
+  if (mBuffer.size() + size > sBufferSize) {
+    flush();  // can throw
+  }
+}
+
+void GerberStreamWriter::writeToDevice(const QByteArray& data) {
+  if (mHash) {
+    // According to the RS-274X standard, line breaks are not included in the
+    // checksum.
+    const char* begin = data.constData();
+    const char* const end = begin + data.size();
+    while (begin < end) {
+      const char* lineEnd = std::find(begin, end, '\n');
+      if (lineEnd > begin) {
+        mHash->addData(begin, static_cast<int>(lineEnd - begin));
+      }
+      begin = (lineEnd < end) ? (lineEnd + 1) : end;
+    }
+  }
+  const qint64 written = mDevice.write(data);
+  if (written != data.size()) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Failed to write output: %1")
+                           .arg(mDevice.errorString()));
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,159 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_GERBERSTREAMWRITER_H
+#define LIBREPCB_CORE_GERBERSTREAMWRITER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class GerberStreamWriter
+ ******************************************************************************/
+
+/**
+ * @brief Buffered writer used to stream Gerber and Excellon files into a
+ *        QIODevice
+ *
+ * The written data is collected in a small buffer which is flushed to the
+ * device whenever it gets full, so the whole file never needs to be held in
+ * memory. If enabled, a MD5 checksum over all written bytes (except line
+ * breaks, as required by the RS-274X standard) is calculated on the fly.
+ *
+ * In addition, this class provides fast integer formatting functions which
+ * append directly to a QByteArray without temporary QString objects.
+ */
+class GerberStreamWriter final {
+  Q_DECLARE_TR_FUNCTIONS(GerberStreamWriter)
+
+public:
+  // Constructors / Destructor
+  GerberStreamWriter() = delete;
+  GerberStreamWriter(const GerberStreamWriter& other) = delete;
+  GerberStreamWriter(QIODevice& device, bool calcMd5Checksum) noexcept;
+  ~GerberStreamWriter() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Write raw bytes
+   *
+   * @param data    Data to write.
+   *
+   * @throws Exception  If flushing the buffer to the device failed.
+   */
+  void write(const QByteArray& data);
+
+  /**
+   * @copydoc #write(const QByteArray&)
+   */
+  void write(const char* data);
+
+  /**
+   * @brief Write an integer in decimal representation
+   *
+   * @param value   The value to write.
+   *
+   * @throws Exception  If flushing the buffer to the device failed.
+   *
+   * @see #appendInteger()
+   */
+  void writeInteger(qint64 value);
+
+  /**
+   * @brief Write a fixed point decimal number
+   *
+   * @param value     The fixed point value to write.
+   * @param pointPos  Number of decimal positions (1..18).
+   *
+   * @throws Exception  If flushing the buffer to the device failed.
+   *
+   * @see #appendDecimalFixedPoint()
+   */
+  void writeDecimalFixedPoint(qint64 value, int pointPos);
+
+  /**
+   * @brief Write all buffered data to the device
+   *
+   * @throws Exception  If writing to the device failed.
+   */
+  void flush();
+
+  /**
+   * @brief Get the MD5 checksum over all data written so far
+   *
+   * @return Lowercase hex representation of the checksum.
+   *
+   * @throws Exception  If flushing the buffer to the device failed.
+   */
+  QByteArray getMd5Checksum();
+
+  // Static Methods
+
+  /**
+   * @brief Append an integer in decimal representation
+   *
+   * Produces the same output as QString::number(), but without any temporary
+   * heap allocation.
+   *
+   * @param out     The array to append to.
+   * @param value   The value to append.
+   */
+  static void appendInteger(QByteArray& out, qint64 value) noexcept;
+
+  /**
+   * @brief Append a fixed point decimal number
+   *
+   * Produces the same output as Toolbox::decimalFixedPointToString(), but
+   * without any temporary heap allocation.
+   *
+   * @param out       The array to append to.
+   * @param value     The fixed point value to append.
+   * @param pointPos  Number of decimal positions (1..18).
+   */
+  static void appendDecimalFixedPoint(QByteArray& out, qint64 value,
+                                      int pointPos) noexcept;
+
+  // Operator Overloadings
+  GerberStreamWriter& operator=(const GerberStreamWriter& rhs) = delete;
+
+private:  // Methods
+  void reserve(int size);
+  void writeToDevice(const QByteArray& data);
+
+private:  // Data
+  QIODevice& mDevice;
+  QByteArray mBuffer;
+  QScopedPointer<QCryptographicHash> mHash;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
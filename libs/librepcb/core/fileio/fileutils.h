@@ -25,6 +25,8 @@
  ******************************************************************************/
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -74,6 +76,23 @@ public:
    */
   static void writeFile(const FilePath& filepath, const QByteArray& content);
 
+  /**
+   * @brief Write a file by streaming its content into a QIODevice
+   *
+   * Same as #writeFile(const FilePath&, const QByteArray&), but the content is
+   * written by a callback instead of being passed as a whole. This avoids
+   * holding large files completely in memory. The file is only replaced if
+   * the callback returns without throwing.
+   *
+   * @param filepath      The file to (over)write
+   * @param writer        Callback which writes the content into the passed
+   *                      device. It may throw to abort writing the file.
+   *
+   * @throws Exception    If an error occurs.
+   */
+  static void writeFile(const FilePath& filepath,
+                        const std::function<void(QIODevice&)>& writer);
+
   /**
    * @brief Copy a single file
    *
@@ -25,10 +25,14 @@
 #include "../serialization/sexpression.h"
 #include "../utils/toolbox.h"
 #include "fileutils.h"
+#include "ziparchive.h"
 
 #include <quazip/quazip.h>
 #include <quazip/quazipdir.h>
 #include <quazip/quazipfile.h>
+#include <quazip/zip.h>
+
+#include <QtConcurrent>
 
 /*******************************************************************************
  *  Namespace
@@ -73,6 +77,8 @@ TransactionalFileSystem::TransactionalFileSystem(
 }
 
 TransactionalFileSystem::~TransactionalFileSystem() noexcept {
+  waitForAutosave();
+
   // Remove autosave directory as it is not needed in case the file system
   // was gracefully closed. We only need it if the application has crashed.
   // But if the file system is opened in read-only mode, or if an autosave was
@@ -112,7 +118,8 @@ QStringList TransactionalFileSystem::getDirs(const QString& path) const
   }
 
   // add directories of new files
-  foreach (const QString& filepath, mModifiedFiles.keys()) {
+  const QStringList newFiles = mModifiedFiles.keys() + mArchiveFiles.values();
+  foreach (const QString& filepath, newFiles) {
     if (filepath.startsWith(dirpath)) {
       QStringList relpath = filepath.mid(dirpath.length()).split('/');
       if (relpath.count() > 1) {
@@ -139,7 +146,8 @@ QStringList TransactionalFileSystem::getFiles(const QString& path) const
   }
 
   // add new files
-  foreach (const QString& filepath, mModifiedFiles.keys()) {
+  const QStringList newFiles = mModifiedFiles.keys() + mArchiveFiles.values();
+  foreach (const QString& filepath, newFiles) {
     if (filepath.startsWith(dirpath)) {
       QStringList relpath = filepath.mid(dirpath.length()).split('/');
       if (relpath.count() == 1) {
@@ -153,7 +161,8 @@ QStringList TransactionalFileSystem::getFiles(const QString& path) const
 
 bool TransactionalFileSystem::fileExists(const QString& path) const noexcept {
   QString cleanedPath = cleanPath(path);
-  if (mModifiedFiles.contains(cleanedPath)) {
+  if (mModifiedFiles.contains(cleanedPath) ||
+      mArchiveFiles.contains(cleanedPath)) {
     return true;
   } else if (isRemoved(cleanedPath)) {
     return false;
@@ -166,8 +175,13 @@ QByteArray TransactionalFileSystem::read(const QString& path) const {
   QString cleanedPath = cleanPath(path);
   if (mModifiedFiles.contains(cleanedPath)) {
     return mModifiedFiles.value(cleanedPath);
+  } else if (mArchiveFiles.contains(cleanedPath)) {
+    return mArchive->read(cleanedPath);  // can throw
   } else if (!isRemoved(cleanedPath)) {
-    return FileUtils::readFile(mFilePath.getPathTo(cleanedPath));  // can throw
+    const QByteArray content =
+        FileUtils::readFile(mFilePath.getPathTo(cleanedPath));  // can throw
+    setDiskContent(cleanedPath, content);
+    return content;
   } else {
     throw RuntimeError(__FILE__, __LINE__,
                        tr("File '%1' does not exist.")
@@ -178,13 +192,21 @@ QByteArray TransactionalFileSystem::read(const QString& path) const {
 void TransactionalFileSystem::write(const QString& path,
                                     const QByteArray& content) {
   QString cleanedPath = cleanPath(path);
-  mModifiedFiles[cleanedPath] = content;
+  mArchiveFiles.remove(cleanedPath);
   mRemovedFiles.remove(cleanedPath);
+  if (isEqualToDiskContent(cleanedPath, content)) {
+    // The file is not modified, so it does not need to be backed up and
+    // written to the disk at all.
+    mModifiedFiles.remove(cleanedPath);
+  } else {
+    mModifiedFiles[cleanedPath] = content;
+  }
 }
 
 void TransactionalFileSystem::removeFile(const QString& path) {
   QString cleanedPath = cleanPath(path);
   mModifiedFiles.remove(cleanedPath);
+  mArchiveFiles.remove(cleanedPath);
   mRemovedFiles.insert(cleanedPath);
 }
 
@@ -196,6 +218,11 @@ void TransactionalFileSystem::removeDirRecursively(const QString& path) {
       mModifiedFiles.remove(fp);
     }
   }
+  foreach (const QString& fp, mArchiveFiles) {
+    if (dirpath.isEmpty() || fp.startsWith(dirpath)) {
+      mArchiveFiles.remove(fp);
+    }
+  }
   foreach (const QString& fp, mRemovedFiles) {
     if (dirpath.isEmpty() || fp.startsWith(dirpath)) {
       mRemovedFiles.remove(fp);
@@ -208,35 +235,12 @@ void TransactionalFileSystem::removeDirRecursively(const QString& path) {
  *  General Methods
  ******************************************************************************/
 
-void TransactionalFileSystem::loadFromZip(QByteArray content) {
-  QBuffer buffer(&content);
-  QuaZip zip(&buffer);
-  if (!zip.open(QuaZip::mdUnzip)) {
-    throw RuntimeError(__FILE__, __LINE__, tr("Failed to open ZIP file '%1'."));
-  }
-  QuaZipFile file(&zip);
-  for (bool f = zip.goToFirstFile(); f; f = zip.goToNextFile()) {
-    file.open(QIODevice::ReadOnly);
-    write(file.getActualFileName(), file.readAll());
-    file.close();
-  }
-  zip.close();
+void TransactionalFileSystem::loadFromZip(const QByteArray& content) {
+  loadArchive(std::make_shared<ZipArchive>(content));  // can throw
 }
 
 void TransactionalFileSystem::loadFromZip(const FilePath& fp) {
-  QuaZip zip(fp.toStr());
-  if (!zip.open(QuaZip::mdUnzip)) {
-    throw RuntimeError(
-        __FILE__, __LINE__,
-        tr("Failed to open the ZIP file '%1'.").arg(fp.toNative()));
-  }
-  QuaZipFile file(&zip);
-  for (bool f = zip.goToFirstFile(); f; f = zip.goToNextFile()) {
-    file.open(QIODevice::ReadOnly);
-    write(file.getActualFileName(), file.readAll());
-    file.close();
-  }
-  zip.close();
+  loadArchive(std::make_shared<ZipArchive>(fp));  // can throw
 }
 
 QByteArray TransactionalFileSystem::exportToZip(FilterFunction filter) const {
@@ -260,7 +264,12 @@ QByteArray TransactionalFileSystem::exportToZip(FilterFunction filter) const {
 }
 
 void TransactionalFileSystem::exportToZip(const FilePath& fp,
-                                          FilterFunction filter) const {
+                                          FilterFunction filter) {
+  // The target might be the loaded (memory-mapped) ZIP file itself, which is
+  // truncated when creating the new ZIP file. So its files need to be read
+  // and the archive released before.
+  extractArchive();  // can throw
+
   QuaZip zip(fp.toStr());
   if (!zip.open(QuaZip::mdCreate)) {
     throw RuntimeError(
@@ -283,6 +292,8 @@ void TransactionalFileSystem::discardChanges() noexcept {
   mModifiedFiles.clear();
   mRemovedFiles.clear();
   mRemovedDirs.clear();
+  mArchive.reset();
+  mArchiveFiles.clear();
 }
 
 QStringList TransactionalFileSystem::checkForModifications() const {
@@ -314,14 +325,50 @@ QStringList TransactionalFileSystem::checkForModifications() const {
     }
   }
 
+  // files of the loaded ZIP archive
+  foreach (const QString& filepath, mArchiveFiles) {
+    FilePath fp = mFilePath.getPathTo(filepath);
+    if ((!fp.isExistingFile()) ||
+        (FileUtils::readFile(fp) != mArchive->read(filepath))) {  // can throw
+      modifications.append(filepath);
+    }
+  }
+
   return modifications;
 }
 
 void TransactionalFileSystem::autosave() {
+  waitForAutosave();
+  extractArchive();  // can throw
   saveDiff("autosave");  // can throw
 }
 
+QFuture<void> TransactionalFileSystem::autosaveAsync() {
+  waitForAutosave();
+  if (!mIsWritable) {
+    throw RuntimeError(__FILE__, __LINE__, tr("File system is read-only."));
+  }
+  extractArchive();  // can throw
+
+  // The containers are implicitly shared, so taking a snapshot is cheap.
+  const FilePath root = mFilePath;
+  const QHash<QString, QByteArray> modifiedFiles = mModifiedFiles;
+  const QSet<QString> removedFiles = mRemovedFiles;
+  const QSet<QString> removedDirs = mRemovedDirs;
+  mAutosaveFuture = QtConcurrent::run([=]() {
+    writeDiff(root, "autosave", modifiedFiles, removedFiles,
+              removedDirs);  // can throw
+  });
+  return mAutosaveFuture;
+}
+
 void TransactionalFileSystem::save() {
+  // an autosave in progress would be outdated and removed anyway
+  waitForAutosave();
+
+  // all files of a loaded ZIP archive need to be written to the disk
+  extractArchive();  // can throw
+
   // save to backup directory
   saveDiff("backup");  // can throw
 
@@ -339,6 +386,12 @@ void TransactionalFileSystem::save() {
     if (fp.isExistingDir()) {
       FileUtils::removeDirRecursively(fp);  // can throw
     }
+    QMutexLocker lock(&mDiskFileHashesMutex);
+    foreach (const QString& filepath, mDiskFileHashes.keys()) {
+      if (filepath.startsWith(dir)) {
+        mDiskFileHashes.remove(filepath);
+      }
+    }
   }
 
   // remove files
@@ -347,12 +400,15 @@ void TransactionalFileSystem::save() {
     if (fp.isExistingFile()) {
       FileUtils::removeFile(fp);  // can throw
     }
+    QMutexLocker lock(&mDiskFileHashesMutex);
+    mDiskFileHashes.remove(filepath);
   }
 
   // save new or modified files
   foreach (const QString& filepath, mModifiedFiles.keys()) {
-    FileUtils::writeFile(mFilePath.getPathTo(filepath),
-                         mModifiedFiles.value(filepath));  // can throw
+    const QByteArray& content = mModifiedFiles.value(filepath);
+    FileUtils::writeFile(mFilePath.getPathTo(filepath), content);  // can throw
+    setDiskContent(filepath, content);
   }
 
   // remove backup
@@ -392,6 +448,61 @@ bool TransactionalFileSystem::isRemoved(const QString& path) const noexcept {
   return false;
 }
 
+bool TransactionalFileSystem::isEqualToDiskContent(
+    const QString& path, const QByteArray& content) const noexcept {
+  if (isRemoved(path)) {
+    return false;  // file will be removed from the disk
+  }
+  QMutexLocker lock(&mDiskFileHashesMutex);
+  const auto it = mDiskFileHashes.constFind(path);
+  return (it != mDiskFileHashes.constEnd()) &&
+      (it->first == content.size()) &&
+      (it->second == calcContentHash(content));
+}
+
+void TransactionalFileSystem::setDiskContent(const QString& path,
+                                             const QByteArray& content) const
+    noexcept {
+  const QByteArray hash = calcContentHash(content);
+  QMutexLocker lock(&mDiskFileHashesMutex);
+  mDiskFileHashes.insert(path, qMakePair(content.size(), hash));
+}
+
+QByteArray TransactionalFileSystem::calcContentHash(
+    const QByteArray& content) noexcept {
+  // Only used to detect unmodified files, no cryptographic strength needed.
+  return QCryptographicHash::hash(content, QCryptographicHash::Md5);
+}
+
+void TransactionalFileSystem::loadArchive(
+    std::shared_ptr<const ZipArchive> archive) {
+  // Only one archive can be pending, so extract a previously loaded one.
+  extractArchive();  // can throw
+  mArchive = archive;
+  foreach (const QString& filepath, mArchive->getFiles()) {
+    mModifiedFiles.remove(filepath);
+    mRemovedFiles.remove(filepath);
+    mArchiveFiles.insert(filepath);
+  }
+}
+
+void TransactionalFileSystem::extractArchive() {
+  if (!mArchive) {
+    return;
+  }
+
+  // Extract all files first to not leave a half-extracted archive behind.
+  QHash<QString, QByteArray> files;
+  foreach (const QString& filepath, mArchiveFiles) {
+    files.insert(filepath, mArchive->read(filepath));  // can throw
+  }
+  mArchive.reset();
+  mArchiveFiles.clear();
+  for (auto it = files.constBegin(); it != files.constEnd(); ++it) {
+    write(it.key(), it.value());
+  }
+}
+
 void TransactionalFileSystem::exportDirToZip(QuaZipFile& file,
                                              const FilePath& zipFp,
                                              const QString& dir,
@@ -417,50 +528,74 @@ void TransactionalFileSystem::exportDirToZip(QuaZipFile& file,
     if (filename == ".lock") continue;
     // apply custom filter
     if (filter && (!filter(filepath))) continue;
-    // read file content and add it to the ZIP archive
-    const QByteArray& content = read(filepath);  // can throw
-    QuaZipNewInfo newFileInfo(filepath);
-    newFileInfo.setPermissions(QFileDevice::ReadOwner | QFileDevice::ReadGroup |
-                               QFileDevice::ReadOther |
-                               QFileDevice::WriteOwner);
-    if (!file.open(QIODevice::WriteOnly, newFileInfo)) {
-      throw RuntimeError(__FILE__, __LINE__);
-    }
-    qint64 bytesWritten = file.write(content);
-    file.close();
-    if (bytesWritten != content.length()) {
-      throw RuntimeError(__FILE__, __LINE__,
-                         tr("Failed to write file '%1' to '%2'.")
-                             .arg(filepath, zipFp.toNative()));
+    exportFileToZip(file, zipFp, filepath);  // can throw
+  }
+}
+
+void TransactionalFileSystem::exportFileToZip(QuaZipFile& file,
+                                              const FilePath& zipFp,
+                                              const QString& filepath) const {
+  QuaZipNewInfo newFileInfo(filepath);
+  newFileInfo.setPermissions(QFileDevice::ReadOwner | QFileDevice::ReadGroup |
+                             QFileDevice::ReadOther | QFileDevice::WriteOwner);
+  if (!file.open(QIODevice::WriteOnly, newFileInfo)) {
+    throw RuntimeError(__FILE__, __LINE__);
+  }
+  bool success = true;
+  if (mModifiedFiles.contains(filepath) || mArchiveFiles.contains(filepath)) {
+    const QByteArray content = read(filepath);  // can throw
+    success = (file.write(content) == content.length());
+  } else {
+    // Unmodified files are streamed from the disk to avoid holding their
+    // whole content in memory.
+    QFile source(mFilePath.getPathTo(filepath).toStr());
+    success = source.open(QIODevice::ReadOnly);
+    while (success && (!source.atEnd())) {
+      const QByteArray chunk = source.read(1 << 16);
+      success = (!chunk.isEmpty()) && (file.write(chunk) == chunk.length());
     }
   }
+  file.close();
+  if ((!success) || (file.getZipError() != ZIP_OK)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Failed to write file '%1' to '%2'.")
+                           .arg(filepath, zipFp.toNative()));
+  }
 }
 
 void TransactionalFileSystem::saveDiff(const QString& type) const {
-  QDateTime dt = QDateTime::currentDateTime();
-  FilePath dir = mFilePath.getPathTo("." % type);
-  FilePath filesDir = dir.getPathTo(dt.toString("yyyy-MM-dd_hh-mm-ss-zzz"));
-
   if (!mIsWritable) {
     throw RuntimeError(__FILE__, __LINE__, tr("File system is read-only."));
   }
 
+  writeDiff(mFilePath, type, mModifiedFiles, mRemovedFiles,
+            mRemovedDirs);  // can throw
+}
+
+void TransactionalFileSystem::writeDiff(
+    const FilePath& fsPath, const QString& type,
+    const QHash<QString, QByteArray>& modifiedFiles,
+    const QSet<QString>& removedFiles, const QSet<QString>& removedDirs) {
+  QDateTime dt = QDateTime::currentDateTime();
+  FilePath dir = fsPath.getPathTo("." % type);
+  FilePath filesDir = dir.getPathTo(dt.toString("yyyy-MM-dd_hh-mm-ss-zzz"));
+
   SExpression root = SExpression::createList("librepcb_" % type);
   root.ensureLineBreak();
   root.appendChild("created", dt);
   root.ensureLineBreak();
   root.appendChild("modified_files_directory", filesDir.getFilename());
-  foreach (const QString& filepath, Toolbox::sorted(mModifiedFiles.keys())) {
+  foreach (const QString& filepath, Toolbox::sorted(modifiedFiles.keys())) {
     root.ensureLineBreak();
     root.appendChild("modified_file", filepath);
     FileUtils::writeFile(filesDir.getPathTo(filepath),
-                         mModifiedFiles.value(filepath));  // can throw
+                         modifiedFiles.value(filepath));  // can throw
   }
-  foreach (const QString& filepath, Toolbox::sorted(mRemovedFiles.values())) {
+  foreach (const QString& filepath, Toolbox::sorted(removedFiles.values())) {
     root.ensureLineBreak();
     root.appendChild("removed_file", filepath);
   }
-  foreach (const QString& filepath, Toolbox::sorted(mRemovedDirs.values())) {
+  foreach (const QString& filepath, Toolbox::sorted(removedDirs.values())) {
     root.ensureLineBreak();
     root.appendChild("removed_directory", filepath);
   }
@@ -495,6 +630,17 @@ void TransactionalFileSystem::loadDiff(const FilePath& fp) {
   }
 }
 
+void TransactionalFileSystem::waitForAutosave() noexcept {
+  try {
+    mAutosaveFuture.waitForFinished();  // can throw
+  } catch (const Exception& e) {
+    qWarning() << "Failed to autosave file system:" << e.getMsg();
+  } catch (...) {
+    qWarning() << "Failed to autosave file system: Unknown error.";
+  }
+  mAutosaveFuture = QFuture<void>();
+}
+
 void TransactionalFileSystem::removeDiff(const QString& type) {
   FilePath dir = mFilePath.getPathTo("." % type);
   FilePath file = dir.getPathTo(type % ".lp");
@@ -39,6 +39,8 @@ class QuaZipFile;
 
 namespace librepcb {
 
+class ZipArchive;
+
 /*******************************************************************************
  *  Class TransactionalFileSystem
  ******************************************************************************/
@@ -60,6 +62,8 @@ namespace librepcb {
  *  - Holds all file modifications in memory and allows to write those in an
  *    atomic way to the disk (see @ref doc_project_save).
  *  - Allows to export the whole file system to a ZIP file.
+ *  - Allows to overlay the content of a ZIP file, which is only extracted
+ *    on demand (see #loadFromZip()).
  */
 class TransactionalFileSystem final : public FileSystem {
   Q_OBJECT
@@ -163,13 +167,48 @@ public:
   virtual void removeDirRecursively(const QString& path = "") override;
 
   // General Methods
-  void loadFromZip(QByteArray content);
+
+  /**
+   * @brief Load all files of a ZIP archive into the file system
+   *
+   * The files are handled like modifications of the file system, but they are
+   * not extracted immediately. Only the central directory of the archive is
+   * read, the content of a file is inflated when it is read the first time.
+   * Saving the file system extracts all remaining files.
+   *
+   * @param content   The ZIP file content.
+   *
+   * @throw ::librepcb::Exception if the archive could not be opened.
+   */
+  void loadFromZip(const QByteArray& content);
+
+  /**
+   * @copydoc loadFromZip(const QByteArray&)
+   *
+   * @note  The ZIP file is memory-mapped (if supported) and must not be
+   *        modified as long as it is loaded.
+   *
+   * @param fp        Path to the ZIP file.
+   */
   void loadFromZip(const FilePath& fp);
   QByteArray exportToZip(FilterFunction filter = nullptr) const;
-  void exportToZip(const FilePath& fp, FilterFunction filter = nullptr) const;
+  void exportToZip(const FilePath& fp, FilterFunction filter = nullptr);
   void discardChanges() noexcept;
   QStringList checkForModifications() const;
   void autosave();
+
+  /**
+   * @brief Start an autosave in a background thread
+   *
+   * Takes a snapshot of the current modifications and writes the autosave
+   * backup in a worker thread. A previous autosave still in progress is
+   * waited for first, so there is at most one autosave in flight. Saving
+   * and destroying the file system wait for it as well.
+   *
+   * @return The future of the autosave. If the autosave fails, it rethrows
+   *         the ::librepcb::Exception when waiting for it.
+   */
+  QFuture<void> autosaveAsync();
   void save();
 
   // Static Methods
@@ -198,9 +237,23 @@ public:
 
 private:  // Methods
   bool isRemoved(const QString& path) const noexcept;
+  bool isEqualToDiskContent(const QString& path,
+                            const QByteArray& content) const noexcept;
+  void setDiskContent(const QString& path, const QByteArray& content) const
+      noexcept;
+  static QByteArray calcContentHash(const QByteArray& content) noexcept;
+  void loadArchive(std::shared_ptr<const ZipArchive> archive);
+  void extractArchive();
   void exportDirToZip(QuaZipFile& file, const FilePath& zipFp,
                       const QString& dir, FilterFunction filter) const;
+  void exportFileToZip(QuaZipFile& file, const FilePath& zipFp,
+                       const QString& filepath) const;
   void saveDiff(const QString& type) const;
+  static void writeDiff(const FilePath& fsPath, const QString& type,
+                        const QHash<QString, QByteArray>& modifiedFiles,
+                        const QSet<QString>& removedFiles,
+                        const QSet<QString>& removedDirs);
+  void waitForAutosave() noexcept;
   void loadDiff(const FilePath& fp);
   void removeDiff(const QString& type);
 
@@ -214,6 +267,16 @@ private:  // Data
   QHash<QString, QByteArray> mModifiedFiles;
   QSet<QString> mRemovedFiles;
   QSet<QString> mRemovedDirs;
+
+  /// Loaded ZIP archive whose files are not extracted yet, if any
+  std::shared_ptr<const ZipArchive> mArchive;
+  QSet<QString> mArchiveFiles;  ///< Files of mArchive not overridden yet
+
+  /// Size and hash of files as they are currently stored on the disk, if known
+  mutable QHash<QString, QPair<int, QByteArray>> mDiskFileHashes;
+  mutable QMutex mDiskFileHashesMutex;
+
+  QFuture<void> mAutosaveFuture;  ///< Autosave running in background, if any
 };
 
 /*******************************************************************************
@@ -0,0 +1,140 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "ziparchive.h"
+
+#include "../exceptions.h"
+#include "transactionalfilesystem.h"
+
+#include <quazip/quazip.h>
+#include <quazip/quazipfile.h>
+#include <quazip/unzip.h>
+
+#include <QtCore>
+
+#include <limits>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ZipArchive::ZipArchive(const QByteArray& content)
+  : mName(tr("ZIP archive")), mFile(), mContent(content), mBuffer() {
+  open();  // can throw
+}
+
+ZipArchive::ZipArchive(const FilePath& fp)
+  : mName(fp.toNative()), mFile(fp.toStr()), mContent(), mBuffer() {
+  if (!mFile.open(QIODevice::ReadOnly)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Failed to open the ZIP file '%1'.").arg(mName));
+  }
+  const qint64 size = mFile.size();
+  uchar* data = nullptr;
+  if ((size > 0) && (size <= std::numeric_limits<int>::max())) {
+    data = mFile.map(0, size);
+  }
+  if (data) {
+    // Note: The mapping stays valid until the file is closed.
+    mContent = QByteArray::fromRawData(reinterpret_cast<const char*>(data),
+                                       static_cast<int>(size));
+  } else {
+    // Memory-mapping is not supported, fall back to reading the whole file.
+    mContent = mFile.readAll();
+    mFile.close();
+  }
+  open();  // can throw
+}
+
+ZipArchive::~ZipArchive() noexcept {
+  mZip->close();
+  mBuffer.close();
+  mContent.clear();  // drop the view to the mapped file before closing it
+  mFile.close();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+QByteArray ZipArchive::read(const QString& path) const {
+  QMutexLocker lock(&mMutex);
+  const auto it = mEntries.constFind(path);
+  if (it == mEntries.constEnd()) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("File '%1' does not exist in '%2'.")
+                           .arg(path, mName));
+  }
+  if (!mZip->setCurrentFile(*it, QuaZip::csSensitive)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Failed to locate file '%1' in '%2'.")
+                           .arg(path, mName));
+  }
+  QuaZipFile file(mZip.data());
+  if (!file.open(QIODevice::ReadOnly)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Failed to open file '%1' in '%2'.")
+                           .arg(path, mName));
+  }
+  const QByteArray content = file.readAll();
+  file.close();  // verifies the CRC
+  if (file.getZipError() != UNZ_OK) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Failed to extract file '%1' from '%2'.")
+                           .arg(path, mName));
+  }
+  return content;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void ZipArchive::open() {
+  // Reading must not detach mContent, otherwise a mapped file would be copied.
+  mBuffer.setBuffer(&mContent);
+  mZip.reset(new QuaZip(&mBuffer));
+  if (!mZip->open(QuaZip::mdUnzip)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Failed to open the ZIP file '%1'.").arg(mName));
+  }
+
+  // Index the central directory once. QuaZip remembers the position of each
+  // visited entry, so later lookups by name do not need to scan it again.
+  for (bool f = mZip->goToFirstFile(); f; f = mZip->goToNextFile()) {
+    const QString name = mZip->getCurrentFileName();
+    if (!name.endsWith('/')) {  // skip directory entries
+      mEntries.insert(TransactionalFileSystem::cleanPath(name), name);
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
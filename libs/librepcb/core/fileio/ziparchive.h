@@ -0,0 +1,121 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_ZIPARCHIVE_H
+#define LIBREPCB_CORE_ZIPARCHIVE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "filepath.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+
+class QuaZip;
+
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class ZipArchive
+ ******************************************************************************/
+
+/**
+ * @brief Read-only random access to the files of a ZIP archive
+ *
+ * The central directory of the archive is indexed once when constructing the
+ * object, the file contents are only inflated when calling #read(). Archives
+ * on the disk are memory-mapped (if supported by the file system) instead of
+ * being loaded into memory, so opening a large archive is cheap and only the
+ * actually accessed entries cost any time.
+ *
+ * @note #read() is thread-safe, but the accesses are serialized since the
+ *       underlying ZIP library is not reentrant.
+ */
+class ZipArchive final {
+  Q_DECLARE_TR_FUNCTIONS(ZipArchive)
+
+public:
+  // Constructors / Destructor
+  ZipArchive() = delete;
+  explicit ZipArchive(const QByteArray& content);
+  explicit ZipArchive(const FilePath& fp);
+  ZipArchive(const ZipArchive& other) = delete;
+  ~ZipArchive() noexcept;
+
+  // Getters
+
+  /**
+   * @brief Get the paths of all files contained in the archive
+   *
+   * @return Cleaned relative file paths (without directory entries).
+   */
+  QStringList getFiles() const noexcept { return mEntries.keys(); }
+
+  /**
+   * @brief Check if the archive contains a specific file
+   *
+   * @param path    Cleaned relative file path.
+   *
+   * @return Whether the file exists or not.
+   */
+  bool contains(const QString& path) const noexcept {
+    return mEntries.contains(path);
+  }
+
+  // General Methods
+
+  /**
+   * @brief Inflate the content of a file
+   *
+   * @param path    Cleaned relative file path.
+   *
+   * @return The uncompressed file content.
+   *
+   * @throw ::librepcb::Exception if the file does not exist or the archive
+   *        is corrupt.
+   */
+  QByteArray read(const QString& path) const;
+
+  // Operator Overloadings
+  ZipArchive& operator=(const ZipArchive& rhs) = delete;
+
+private:  // Methods
+  void open();
+
+private:  // Data
+  QString mName;  ///< Used for error messages
+  QFile mFile;  ///< Only open if memory-mapped
+  QByteArray mContent;  ///< Owned data, or a raw view to the mapped file
+  QBuffer mBuffer;
+  QScopedPointer<QuaZip> mZip;
+  QHash<QString, QString> mEntries;  ///< Cleaned path -> name in archive
+  mutable QMutex mMutex;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
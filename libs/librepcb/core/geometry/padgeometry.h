@@ -122,6 +122,18 @@ private:  // Data
   HoleList mHoles;
 };
 
+/*******************************************************************************
+ *  Non-Member Functions
+ ******************************************************************************/
+
+inline uint qHash(const PadGeometry& key, uint seed = 0) noexcept {
+  return ::qHash(qMakePair(qMakePair(static_cast<int>(key.getShape()),
+                                     key.getCornerRadius()),
+                           qMakePair(key.getWidth(), key.getHeight())),
+                 seed) ^
+      ::qHash(qMakePair(key.getPath(), key.getHoles().count()), seed);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,95 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "padgeometrycache.h"
+
+#include <QtCore>
+#include <QtGui>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+PadGeometryCache::PadGeometryCache() noexcept
+  : mMutex(), mPaths(10000), mFilledPaths(10000) {
+}
+
+PadGeometryCache::~PadGeometryCache() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+QPainterPath PadGeometryCache::getQPainterPathPx(
+    const PadGeometry& geometry) noexcept {
+  return get(mPaths, geometry, false);
+}
+
+QPainterPath PadGeometryCache::getFilledQPainterPathPx(
+    const PadGeometry& geometry) noexcept {
+  return get(mFilledPaths, geometry, true);
+}
+
+int PadGeometryCache::count() const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mPaths.count() + mFilledPaths.count();
+}
+
+void PadGeometryCache::clear() noexcept {
+  QMutexLocker lock(&mMutex);
+  mPaths.clear();
+  mFilledPaths.clear();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QPainterPath PadGeometryCache::get(QCache<PadGeometry, QPainterPath>& cache,
+                                   const PadGeometry& geometry,
+                                   bool filled) noexcept {
+  {
+    QMutexLocker lock(&mMutex);
+    if (const QPainterPath* path = cache.object(geometry)) {
+      return *path;
+    }
+  }
+
+  // Build the path without holding the lock, it's the expensive part.
+  const QPainterPath path = filled ? geometry.toFilledQPainterPathPx()
+                                   : geometry.toQPainterPathPx();
+  QMutexLocker lock(&mMutex);
+  cache.insert(geometry, new QPainterPath(path));  // takes ownership
+  return path;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
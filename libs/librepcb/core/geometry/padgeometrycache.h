@@ -0,0 +1,124 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_PADGEOMETRYCACHE_H
+#define LIBREPCB_CORE_PADGEOMETRYCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "padgeometry.h"
+
+#include <QtCore>
+#include <QtGui>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class PadGeometryCache
+ ******************************************************************************/
+
+/**
+ * @brief Process-wide cache of the painter paths of pad geometries
+ *
+ * Boards usually contain many identical pads (e.g. thousands of 0402 pads),
+ * but building the painter path of a ::librepcb::PadGeometry is expensive.
+ * This cache builds the painter path only once per distinct geometry and
+ * returns implicitly shared copies of it, so all pad instances share the
+ * same memory and only carry their own transform.
+ *
+ * The cache is limited in size, least recently used entries are removed
+ * first. All methods are thread-safe.
+ */
+class PadGeometryCache final {
+public:
+  // Constructors / Destructor
+  PadGeometryCache(const PadGeometryCache& other) = delete;
+  ~PadGeometryCache() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Get the (cached) result of
+   *        ::librepcb::PadGeometry::toQPainterPathPx()
+   *
+   * @param geometry  The pad geometry.
+   *
+   * @return The painter path of the pad, with holes subtracted.
+   */
+  QPainterPath getQPainterPathPx(const PadGeometry& geometry) noexcept;
+
+  /**
+   * @brief Get the (cached) result of
+   *        ::librepcb::PadGeometry::toFilledQPainterPathPx()
+   *
+   * @param geometry  The pad geometry.
+   *
+   * @return The painter path of the pad, without holes.
+   */
+  QPainterPath getFilledQPainterPathPx(const PadGeometry& geometry) noexcept;
+
+  /**
+   * @brief Get the number of cached painter paths
+   *
+   * @return Number of cached paths (both filled and not filled).
+   */
+  int count() const noexcept;
+
+  /**
+   * @brief Remove all cached painter paths
+   */
+  void clear() noexcept;
+
+  // Static Methods
+
+  /**
+   * @brief Get the singleton instance
+   *
+   * @return The cache shared by the whole process.
+   */
+  static PadGeometryCache& instance() noexcept {
+    static PadGeometryCache cache;
+    return cache;
+  }
+
+  // Operator Overloadings
+  PadGeometryCache& operator=(const PadGeometryCache& rhs) = delete;
+
+private:  // Methods
+  PadGeometryCache() noexcept;
+  QPainterPath get(QCache<PadGeometry, QPainterPath>& cache,
+                   const PadGeometry& geometry, bool filled) noexcept;
+
+private:  // Data
+  mutable QMutex mMutex;
+  QCache<PadGeometry, QPainterPath> mPaths;
+  QCache<PadGeometry, QPainterPath> mFilledPaths;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
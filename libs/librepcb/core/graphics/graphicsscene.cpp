@@ -55,14 +55,34 @@ GraphicsScene::~GraphicsScene() noexcept {
  *  General Methods
  ******************************************************************************/
 
-void GraphicsScene::addItem(QGraphicsItem& item) noexcept {
+void GraphicsScene::addItem(QGraphicsItem& item, QObject* owner) noexcept {
   QGraphicsScene::addItem(&item);
+  if (owner) {
+    mItemOwners.insert(&item, owner);
+  }
 }
 
 void GraphicsScene::removeItem(QGraphicsItem& item) noexcept {
+  mItemOwners.remove(&item);
   QGraphicsScene::removeItem(&item);
 }
 
+QSet<QObject*> GraphicsScene::getItemOwnersInRect(const QRectF& rectPx) const
+    noexcept {
+  QSet<QObject*> owners;
+  foreach (const QGraphicsItem* item,
+           items(rectPx, Qt::IntersectsItemBoundingRect)) {
+    // Child items belong to the owner of their parent.
+    for (; item; item = item->parentItem()) {
+      if (QObject* owner = mItemOwners.value(item)) {
+        owners.insert(owner);
+        break;
+      }
+    }
+  }
+  return owners;
+}
+
 void GraphicsScene::setSelectionRectColors(const QColor& line,
                                            const QColor& fill) noexcept {
   mSelectionRectItem->setPen(QPen(line, 0));
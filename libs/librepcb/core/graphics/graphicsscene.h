@@ -49,8 +49,32 @@ public:
   ~GraphicsScene() noexcept;
 
   // General Methods
-  void addItem(QGraphicsItem& item) noexcept;
+
+  /**
+   * @brief Add an item to the scene
+   *
+   * @param item    The item to add.
+   * @param owner   Optional object the item belongs to (e.g. a board item),
+   *                used by #getItemOwnersInRect().
+   */
+  void addItem(QGraphicsItem& item, QObject* owner = nullptr) noexcept;
   void removeItem(QGraphicsItem& item) noexcept;
+
+  /**
+   * @brief Get the owners of all visible items close to a given area
+   *
+   * Uses the spatial index of the scene, which is updated incrementally
+   * whenever items are added, removed, moved or changing their geometry. So
+   * this is cheap even for huge scenes and can be used to find the few
+   * candidates for expensive hit tests with their exact shapes.
+   *
+   * @param rectPx  The area to look at in scene coordinates.
+   *
+   * @return Owners (as passed to #addItem()) of all items (or their children)
+   *         whose bounding rect intersects with the given area.
+   */
+  QSet<QObject*> getItemOwnersInRect(const QRectF& rectPx) const noexcept;
+
   void setSelectionRectColors(const QColor& line, const QColor& fill) noexcept;
   void setSelectionRect(const Point& p1, const Point& p2) noexcept;
   QPixmap toPixmap(int dpi,
@@ -60,6 +84,7 @@ public:
 
 private:
   QGraphicsRectItem* mSelectionRectItem;
+  QHash<const QGraphicsItem*, QObject*> mItemOwners;
 };
 
 /*******************************************************************************
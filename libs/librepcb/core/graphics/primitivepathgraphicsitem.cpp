@@ -124,6 +124,13 @@ void PrimitivePathGraphicsItem::paint(QPainter* painter,
                                       QWidget* widget) noexcept {
   Q_UNUSED(widget);
 
+  // Skip items smaller than a pixel, they would not be visible anyway.
+  const qreal lod =
+      option->levelOfDetailFromTransform(painter->worldTransform());
+  if ((qMax(mBoundingRect.width(), mBoundingRect.height()) * lod) < 1) {
+    return;
+  }
+
   const bool isSelected = option->state.testFlag(QStyle::State_Selected);
 
   painter->setPen(isSelected ? mPenHighlighted : mPen);
@@ -127,12 +127,23 @@ void PrimitiveTextGraphicsItem::paint(QPainter* painter,
                                       const QStyleOptionGraphicsItem* option,
                                       QWidget* widget) noexcept {
   Q_UNUSED(widget);
-  painter->setFont(mFont);
-  if (option->state.testFlag(QStyle::State_Selected)) {
-    painter->setPen(mPenHighlighted);
-  } else {
-    painter->setPen(mPen);
+  const qreal lod =
+      option->levelOfDetailFromTransform(painter->worldTransform());
+  const QPen& pen = option->state.testFlag(QStyle::State_Selected)
+      ? mPenHighlighted
+      : mPen;
+
+  if ((mFont.pixelSize() * lod) < 3) {
+    // The text would not be readable anyway, so only indicate its area
+    // instead of doing the expensive text layouting and rendering.
+    QColor color = pen.color();
+    color.setAlphaF(color.alphaF() / 2);
+    painter->fillRect(mBoundingRect, color);
+    return;
   }
+
+  painter->setFont(mFont);
+  painter->setPen(pen);
   painter->drawText(QRectF(), mTextFlags, mText);
 }
 
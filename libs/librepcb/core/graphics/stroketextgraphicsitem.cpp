@@ -100,6 +100,27 @@ QPainterPath StrokeTextGraphicsItem::shape() const noexcept {
   return PrimitivePathGraphicsItem::shape() + mOriginCrossGraphicsItem->shape();
 }
 
+void StrokeTextGraphicsItem::paint(QPainter* painter,
+                                   const QStyleOptionGraphicsItem* option,
+                                   QWidget* widget) noexcept {
+  const qreal lod =
+      option->levelOfDetailFromTransform(painter->worldTransform());
+  if ((mText.getHeight()->toPx() * lod) >= 3) {
+    PrimitivePathGraphicsItem::paint(painter, option, widget);
+    return;
+  }
+
+  // The glyphs would not be readable anyway, so only indicate the area of
+  // the text instead of drawing all the strokes.
+  const bool isSelected = option->state.testFlag(QStyle::State_Selected);
+  const QPen& pen = isSelected ? mPenHighlighted : mPen;
+  if (pen.style() != Qt::NoPen) {
+    QColor color = pen.color();
+    color.setAlphaF(color.alphaF() / 2);
+    painter->fillRect(mPainterPath.boundingRect(), color);
+  }
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -140,6 +140,13 @@ std::unique_ptr<Component> Component::open(
   const QString fileName = getLongElementName() % ".lp";
   const SExpression root = SExpression::parse(directory->read(fileName),
                                               directory->getAbsPath(fileName));
+  return open(std::move(directory), root);
+}
+
+std::unique_ptr<Component> Component::open(
+    std::unique_ptr<TransactionalDirectory> directory,
+    const SExpression& root) {
+  Q_ASSERT(directory);
   return std::unique_ptr<Component>(new Component(std::move(directory), root));
 }
 
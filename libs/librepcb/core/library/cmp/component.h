@@ -138,6 +138,10 @@ public:
   // Static Methods
   static std::unique_ptr<Component> open(
       std::unique_ptr<TransactionalDirectory> directory);
+  /// Same as #open(), but with the already parsed (and up to date) file
+  static std::unique_ptr<Component> open(
+      std::unique_ptr<TransactionalDirectory> directory,
+      const SExpression& root);
   static QString getShortElementName() noexcept {
     return QStringLiteral("cmp");
   }
@@ -118,6 +118,8 @@ public:
     return dir.fileExists((path.isEmpty() ? path : path % "/") % ".librepcb-" %
                           ElementType::getShortElementName());
   }
+  static Version readFileFormat(const TransactionalDirectory& directory,
+                                const QString& fileName);
 
 protected:  // Methods
   /**
@@ -127,9 +129,6 @@ protected:  // Methods
    */
   virtual void serialize(SExpression& root) const;
 
-  static Version readFileFormat(const TransactionalDirectory& directory,
-                                const QString& fileName);
-
 protected:  // Data
   // General Attributes
   const QString mShortElementName;  ///< e.g. "lib", "cmpcat"
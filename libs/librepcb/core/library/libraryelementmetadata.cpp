@@ -0,0 +1,208 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "libraryelementmetadata.h"
+
+#include "../fileio/transactionaldirectory.h"
+#include "../serialization/fileformatmigration.h"
+#include "../serialization/sexpression.h"
+#include "cat/componentcategory.h"
+#include "cat/packagecategory.h"
+#include "cmp/component.h"
+#include "dev/device.h"
+#include "pkg/package.h"
+#include "sym/symbol.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Helper Functions
+ ******************************************************************************/
+
+template <typename ElementType>
+static void upgrade(FileFormatMigration& migration,
+                    TransactionalDirectory& dir);
+
+template <>
+void upgrade<ComponentCategory>(FileFormatMigration& migration,
+                                TransactionalDirectory& dir) {
+  migration.upgradeComponentCategory(dir);
+}
+
+template <>
+void upgrade<PackageCategory>(FileFormatMigration& migration,
+                              TransactionalDirectory& dir) {
+  migration.upgradePackageCategory(dir);
+}
+
+template <>
+void upgrade<Symbol>(FileFormatMigration& migration,
+                     TransactionalDirectory& dir) {
+  migration.upgradeSymbol(dir);
+}
+
+template <>
+void upgrade<Package>(FileFormatMigration& migration,
+                      TransactionalDirectory& dir) {
+  migration.upgradePackage(dir);
+}
+
+template <>
+void upgrade<Component>(FileFormatMigration& migration,
+                        TransactionalDirectory& dir) {
+  migration.upgradeComponent(dir);
+}
+
+template <>
+void upgrade<Device>(FileFormatMigration& migration,
+                     TransactionalDirectory& dir) {
+  migration.upgradeDevice(dir);
+}
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+LibraryElementMetadata::LibraryElementMetadata(
+    const LibraryElementMetadata& other) noexcept
+  : mDirectory(other.mDirectory),
+    mUuid(other.mUuid),
+    mVersion(other.mVersion),
+    mIsDeprecated(other.mIsDeprecated),
+    mNames(other.mNames),
+    mDescriptions(other.mDescriptions),
+    mKeywords(other.mKeywords),
+    mCategories(other.mCategories),
+    mParentUuid(other.mParentUuid),
+    mComponentUuid(other.mComponentUuid),
+    mPackageUuid(other.mPackageUuid) {
+}
+
+LibraryElementMetadata::LibraryElementMetadata(const FilePath& directory,
+                                               const SExpression& root)
+  : mDirectory(directory),
+    mUuid(deserialize<Uuid>(root.getChild("@0"))),
+    mVersion(deserialize<Version>(root.getChild("version/@0"))),
+    mIsDeprecated(deserialize<bool>(root.getChild("deprecated/@0"))),
+    mNames(root),
+    mDescriptions(root),
+    mKeywords(root),
+    mCategories(),
+    mParentUuid(),
+    mComponentUuid(),
+    mPackageUuid() {
+  foreach (const SExpression* node, root.getChildren("category")) {
+    mCategories.insert(deserialize<Uuid>(node->getChild("@0")));
+  }
+  if (const SExpression* node = root.tryGetChild("parent/@0")) {
+    mParentUuid = deserialize<tl::optional<Uuid>>(*node);
+  }
+  if (const SExpression* node = root.tryGetChild("component/@0")) {
+    mComponentUuid = deserialize<Uuid>(*node);
+  }
+  if (const SExpression* node = root.tryGetChild("package/@0")) {
+    mPackageUuid = deserialize<Uuid>(*node);
+  }
+
+  // Check directory name, like LibraryBaseElement does.
+  const QString dirName = mDirectory.getFilename();
+  if (dirName != mUuid.toStr()) {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        QString("Directory name UUID mismatch: '%1' != '%2'\n\nDirectory: '%3'")
+            .arg(dirName, mUuid.toStr(), mDirectory.toNative()));
+  }
+}
+
+LibraryElementMetadata::~LibraryElementMetadata() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QStringList LibraryElementMetadata::getAllAvailableLocales() const noexcept {
+  QStringList list;
+  list.append(mNames.keys());
+  list.append(mDescriptions.keys());
+  list.append(mKeywords.keys());
+  list.removeDuplicates();
+  list.sort(Qt::CaseSensitive);
+  return list;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+template <typename ElementType>
+LibraryElementMetadata LibraryElementMetadata::open(
+    TransactionalDirectory& directory) {
+  // Upgrade file format, if needed.
+  const Version fileFormat = LibraryBaseElement::readFileFormat(
+      directory, ".librepcb-" % ElementType::getShortElementName());
+  for (auto migration : FileFormatMigration::getMigrations(fileFormat)) {
+    upgrade<ElementType>(*migration, directory);
+  }
+
+  // Load metadata. All other nodes (which may be huge, e.g. footprints) are
+  // skipped by the parser.
+  static const QSet<QByteArray> childNames = {
+      "name",     "description", "keywords", "version",   "deprecated",
+      "category", "parent",      "component", "package",
+  };
+  const QString fileName = ElementType::getLongElementName() % ".lp";
+  const SExpression root =
+      SExpression::parse(directory.read(fileName),
+                         directory.getAbsPath(fileName), childNames);
+  if (std::is_same<ElementType, Device>::value) {
+    // Devices must reference a component and a package.
+    root.getChild("component/@0");  // can throw
+    root.getChild("package/@0");  // can throw
+  }
+  return LibraryElementMetadata(directory.getAbsPath(), root);
+}
+
+// Explicit template instantiations.
+template LibraryElementMetadata LibraryElementMetadata::open<
+    ComponentCategory>(TransactionalDirectory& directory);
+template LibraryElementMetadata LibraryElementMetadata::open<PackageCategory>(
+    TransactionalDirectory& directory);
+template LibraryElementMetadata LibraryElementMetadata::open<Symbol>(
+    TransactionalDirectory& directory);
+template LibraryElementMetadata LibraryElementMetadata::open<Package>(
+    TransactionalDirectory& directory);
+template LibraryElementMetadata LibraryElementMetadata::open<Component>(
+    TransactionalDirectory& directory);
+template LibraryElementMetadata LibraryElementMetadata::open<Device>(
+    TransactionalDirectory& directory);
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,128 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_LIBRARYELEMENTMETADATA_H
+#define LIBREPCB_CORE_LIBRARYELEMENTMETADATA_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../serialization/serializablekeyvaluemap.h"
+#include "../types/uuid.h"
+#include "../types/version.h"
+
+#include <optional.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class SExpression;
+class TransactionalDirectory;
+
+/*******************************************************************************
+ *  Class LibraryElementMetadata
+ ******************************************************************************/
+
+/**
+ * @brief Metadata of a library element, loaded without its content
+ *
+ * Contains only the attributes required to index library elements, for
+ * example in the ::librepcb::WorkspaceLibraryDb. Loading the metadata is much
+ * faster than opening the element itself since all the geometry (pins, pads,
+ * footprints, polygons etc.) is skipped when parsing the element file.
+ */
+class LibraryElementMetadata final {
+public:
+  // Constructors / Destructor
+  LibraryElementMetadata() = delete;
+  LibraryElementMetadata(const LibraryElementMetadata& other) noexcept;
+  ~LibraryElementMetadata() noexcept;
+
+  // Getters
+  const FilePath& getDirectory() const noexcept { return mDirectory; }
+  const Uuid& getUuid() const noexcept { return mUuid; }
+  const Version& getVersion() const noexcept { return mVersion; }
+  bool isDeprecated() const noexcept { return mIsDeprecated; }
+  const LocalizedNameMap& getNames() const noexcept { return mNames; }
+  const LocalizedDescriptionMap& getDescriptions() const noexcept {
+    return mDescriptions;
+  }
+  const LocalizedKeywordsMap& getKeywords() const noexcept { return mKeywords; }
+  QStringList getAllAvailableLocales() const noexcept;
+  const QSet<Uuid>& getCategories() const noexcept { return mCategories; }
+  const tl::optional<Uuid>& getParentUuid() const noexcept {
+    return mParentUuid;
+  }
+  const tl::optional<Uuid>& getComponentUuid() const noexcept {
+    return mComponentUuid;
+  }
+  const tl::optional<Uuid>& getPackageUuid() const noexcept {
+    return mPackageUuid;
+  }
+
+  // Operator Overloadings
+  LibraryElementMetadata& operator=(const LibraryElementMetadata& rhs) =
+      delete;
+
+  // Static Methods
+
+  /**
+   * @brief Load the metadata of a library element
+   *
+   * Performs the same file format upgrades and validations as
+   * `ElementType::open()`, but parses only the header of the element file.
+   *
+   * @tparam ElementType  Type of the library element (e.g.
+   *                      ::librepcb::Package).
+   * @param directory     Directory of the element. Note that file format
+   *                      upgrades are applied to this directory.
+   * @return The loaded metadata.
+   * @throws ::librepcb::Exception if the element could not be loaded.
+   */
+  template <typename ElementType>
+  static LibraryElementMetadata open(TransactionalDirectory& directory);
+
+private:  // Methods
+  LibraryElementMetadata(const FilePath& directory, const SExpression& root);
+
+private:  // Data
+  FilePath mDirectory;
+  Uuid mUuid;
+  Version mVersion;
+  bool mIsDeprecated;
+  LocalizedNameMap mNames;
+  LocalizedDescriptionMap mDescriptions;
+  LocalizedKeywordsMap mKeywords;
+  QSet<Uuid> mCategories;  ///< Empty for categories
+  tl::optional<Uuid> mParentUuid;  ///< Only set for categories
+  tl::optional<Uuid> mComponentUuid;  ///< Only set for devices
+  tl::optional<Uuid> mPackageUuid;  ///< Only set for devices
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
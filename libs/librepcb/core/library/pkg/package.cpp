@@ -79,6 +79,13 @@ std::unique_ptr<Package> Package::open(
   const QString fileName = getLongElementName() % ".lp";
   const SExpression root = SExpression::parse(directory->read(fileName),
                                               directory->getAbsPath(fileName));
+  return open(std::move(directory), root);
+}
+
+std::unique_ptr<Package> Package::open(
+    std::unique_ptr<TransactionalDirectory> directory,
+    const SExpression& root) {
+  Q_ASSERT(directory);
   return std::unique_ptr<Package>(new Package(std::move(directory), root));
 }
 
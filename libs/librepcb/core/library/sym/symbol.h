@@ -93,6 +93,10 @@ public:
   // Static Methods
   static std::unique_ptr<Symbol> open(
       std::unique_ptr<TransactionalDirectory> directory);
+  /// Same as #open(), but with the already parsed (and up to date) file
+  static std::unique_ptr<Symbol> open(
+      std::unique_ptr<TransactionalDirectory> directory,
+      const SExpression& root);
   static QString getShortElementName() noexcept {
     return QStringLiteral("sym");
   }
@@ -31,6 +31,7 @@
 #include "../../library/pkg/footprint.h"
 #include "../../serialization/sexpression.h"
 #include "../../types/lengthunit.h"
+#include "../../utils/clipperhelpers.h"
 #include "../../utils/scopeguardlist.h"
 #include "../../utils/toolbox.h"
 #include "../circuit/circuit.h"
@@ -56,10 +57,12 @@
 #include "items/bi_stroketext.h"
 #include "items/bi_via.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
 #include <algorithm>
+#include <functional>
 
 /*******************************************************************************
  *  Namespace
@@ -101,11 +104,21 @@ Board::Board(Project& project,
           &Board::updateErcMessages);
   connect(&mProject.getCircuit(), &Circuit::componentRemoved, this,
           &Board::updateErcMessages);
+
+  // Apply airwires when they have been built in the background.
+  connect(&mAirWiresRebuildWatcher, &QFutureWatcher<AirWiresMap>::finished,
+          this, &Board::airWiresRebuildFinished);
 }
 
 Board::~Board() noexcept {
   Q_ASSERT(!mIsAddedToProject);
 
+  // abort airwires rebuild
+  if (mAirWiresRebuildAbortFlag) {
+    *mAirWiresRebuildAbortFlag = true;
+  }
+  mAirWiresRebuildWatcher.waitForFinished();
+
   qDeleteAll(mErcMsgListUnplacedComponentInstances);
   mErcMsgListUnplacedComponentInstances.clear();
 
@@ -184,6 +197,16 @@ QList<BI_Base*> Board::getAllItems() const noexcept {
   return items;
 }
 
+QSet<BI_Base*> Board::getItemsInRect(const QRectF& rectPx) const noexcept {
+  QSet<BI_Base*> items;
+  foreach (QObject* owner, mGraphicsScene->getItemOwnersInRect(rectPx)) {
+    if (BI_Base* item = qobject_cast<BI_Base*>(owner)) {
+      items.insert(item);
+    }
+  }
+  return items;
+}
+
 /*******************************************************************************
  *  DeviceInstance Methods
  ******************************************************************************/
@@ -286,14 +309,118 @@ void Board::removePlane(BI_Plane& plane) {
 }
 
 void Board::rebuildAllPlanes() noexcept {
+  mPlanesInputHash = calculatePlanesInputHash();
+  rebuildPlanes(mPlanes.values());
+}
+
+void Board::rebuildPlanes(const QVector<Path>& affectedAreas) noexcept {
+  // Only planes touching the affected areas need to be rebuilt. In addition,
+  // planes with lower priority on the same layer need to be rebuilt if they
+  // touch a rebuilt plane since they subtract its fragments. All other planes
+  // keep their current fragments.
+  const PositiveLength tolerance(5000);
+  const ClipperLib::IntRect area = ClipperHelpers::getBounds(
+      ClipperHelpers::convert(affectedAreas, tolerance));
+  auto getPlaneBounds = [&tolerance](const BI_Plane& plane) {
+    ClipperLib::IntRect bounds = ClipperHelpers::getBounds(
+        {ClipperHelpers::convert(plane.getOutline(), tolerance)});
+    bounds.left -= plane.getMinClearance()->toNm();
+    bounds.top -= plane.getMinClearance()->toNm();
+    bounds.right += plane.getMinClearance()->toNm();
+    bounds.bottom += plane.getMinClearance()->toNm();
+    return bounds;
+  };
   QList<BI_Plane*> planes = mPlanes.values();
   std::sort(planes.begin(), planes.end(),
             [](const BI_Plane* p1, const BI_Plane* p2) {
               return !(*p1 < *p2);
             });  // sort by priority (highest priority first)
+  QList<BI_Plane*> dirtyPlanes;
+  QMultiHash<QString, ClipperLib::IntRect> dirtyBounds;
   foreach (BI_Plane* plane, planes) {
-    BoardPlaneFragmentsBuilder builder(*plane);
-    plane->setCalculatedFragments(builder.buildFragments());
+    const ClipperLib::IntRect bounds = getPlaneBounds(*plane);
+    bool dirty = ClipperHelpers::overlaps(bounds, area);
+    foreach (const ClipperLib::IntRect& other,
+             dirtyBounds.values(*plane->getLayerName())) {
+      dirty = dirty || ClipperHelpers::overlaps(bounds, other);
+    }
+    if (dirty) {
+      dirtyPlanes.append(plane);
+      dirtyBounds.insert(*plane->getLayerName(), bounds);
+    }
+  }
+  rebuildPlanes(dirtyPlanes);
+
+  // Planes which were not rebuilt might be outdated (e.g. because traces were
+  // modified in the meantime), thus the current fragments must not be used as
+  // plane fragments cache. This also avoids hashing the whole board after
+  // every partial rebuild.
+  mPlanesInputHash.clear();
+}
+
+void Board::restoreAllPlanes(const QHash<Uuid, QVector<Path>>& fragments,
+                             const QByteArray& inputHash) noexcept {
+  mPlanesInputHash = inputHash;
+  foreach (BI_Plane* plane, mPlanes) {
+    plane->setCalculatedFragments(fragments.value(plane->getUuid()));
+  }
+}
+
+QByteArray Board::calculatePlanesInputHash() const noexcept {
+  // Hash everything which is taken into account by
+  // BoardPlaneFragmentsBuilder, including the application version since the
+  // algorithm might change.
+  try {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    auto addNode = [&hash](const QString& name,
+                           std::function<void(SExpression&)> serializer) {
+      SExpression node = SExpression::createList(name);
+      serializer(node);
+      hash.addData(node.toByteArray());
+    };
+    hash.addData(qApp->getAppVersion().toStr().toUtf8());
+    hash.addData(qApp->getGitRevision().toUtf8());
+    addNode("design_rules",
+            [this](SExpression& n) { mDesignRules->serialize(n); });
+    QSet<const Footprint*> footprints;
+    foreach (const BI_Device* device, mDeviceInstances) {
+      addNode("device", [device](SExpression& n) { device->serialize(n); });
+      const Footprint& footprint = device->getLibFootprint();
+      if (!footprints.contains(&footprint)) {
+        addNode("footprint",
+                [&footprint](SExpression& n) { footprint.serialize(n); });
+        footprints.insert(&footprint);
+      }
+      foreach (const BI_FootprintPad* pad, device->getPads()) {
+        const NetSignal* netSignal = pad->getCompSigInstNetSignal();
+        addNode("pad", [pad, netSignal](SExpression& n) {
+          n.appendChild(pad->getLibPadUuid());
+          n.appendChild("net",
+                        netSignal ? tl::make_optional(netSignal->getUuid())
+                                  : tl::optional<Uuid>());
+        });
+      }
+    }
+    foreach (const BI_NetSegment* netSegment, mNetSegments) {
+      addNode("netsegment",
+              [netSegment](SExpression& n) { netSegment->serialize(n); });
+    }
+    foreach (const BI_Plane* plane, mPlanes) {
+      addNode("plane", [plane](SExpression& n) { plane->serialize(n); });
+    }
+    foreach (const BI_Polygon* polygon, mPolygons) {
+      addNode("polygon", [polygon](SExpression& n) {
+        polygon->getPolygon().serialize(n);
+      });
+    }
+    foreach (const BI_Hole* hole, mHoles) {
+      addNode("hole",
+              [hole](SExpression& n) { hole->getHole().serialize(n); });
+    }
+    return hash.result().toHex();
+  } catch (const Exception& e) {
+    qWarning() << "Failed to calculate hash of plane inputs:" << e.getMsg();
+    return QByteArray();
   }
 }
 
@@ -392,36 +519,8 @@ void Board::removeHole(BI_Hole& hole) {
  ******************************************************************************/
 
 void Board::triggerAirWiresRebuild() noexcept {
-  if (!mIsAddedToProject) {
-    return;
-  }
-
-  try {
-    foreach (NetSignal* netsignal, mScheduledNetSignalsForAirWireRebuild) {
-      // remove old airwires
-      while (BI_AirWire* airWire = mAirWires.take(netsignal)) {
-        airWire->removeFromBoard();  // can throw
-        delete airWire;
-      }
-
-      if (netsignal && netsignal->isAddedToCircuit()) {
-        // calculate new airwires
-        BoardAirWiresBuilder builder(*this, *netsignal);
-        QVector<QPair<Point, Point>> airwires = builder.buildAirWires();
-
-        // add new airwires
-        foreach (const auto& points, airwires) {
-          QScopedPointer<BI_AirWire> airWire(
-              new BI_AirWire(*this, *netsignal, points.first, points.second));
-          airWire->addToBoard();  // can throw
-          mAirWires.insertMulti(netsignal, airWire.take());
-        }
-      }
-    }
-    mScheduledNetSignalsForAirWireRebuild.clear();
-  } catch (const std::exception&
-               e) {  // std::exception because of the many std containers...
-    qCritical() << "Failed to build airwires:" << e.what();
+  if (mIsAddedToProject && (!mScheduledNetSignalsForAirWireRebuild.isEmpty())) {
+    startAirWiresRebuild(true);
   }
 }
 
@@ -429,7 +528,9 @@ void Board::forceAirWiresRebuild() noexcept {
   mScheduledNetSignalsForAirWireRebuild.unite(
       Toolbox::toSet(mProject.getCircuit().getNetSignals().values()));
   mScheduledNetSignalsForAirWireRebuild.unite(Toolbox::toSet(mAirWires.keys()));
-  triggerAirWiresRebuild();
+  if (mIsAddedToProject) {
+    startAirWiresRebuild(false);
+  }
 }
 
 /*******************************************************************************
@@ -686,6 +787,29 @@ void Board::save() {
     root.ensureLineBreak();
     mDirectory->write("settings.user.lp", root.toByteArray());
   }
+
+  // Plane fragments cache, allows to skip rebuilding the planes when opening
+  // the board the next time (see ProjectLoader). It is only valid as long as
+  // the planes input hash still matches.
+  const QString planesCacheFp = "planes.user.lp";
+  if ((!mPlanes.isEmpty()) && (!mPlanesInputHash.isEmpty())) {
+    SExpression root = SExpression::createList("librepcb_board_planes_cache");
+    root.appendChild(QString::fromLatin1(mPlanesInputHash));
+    for (const BI_Plane* plane : mPlanes) {
+      root.ensureLineBreak();
+      SExpression& node = root.appendList("plane");
+      node.appendChild(plane->getUuid());
+      for (const Path& fragment : plane->getFragments()) {
+        node.ensureLineBreak();
+        fragment.serialize(node.appendList("fragment"));
+      }
+      node.ensureLineBreak();
+    }
+    root.ensureLineBreak();
+    mDirectory->write(planesCacheFp, root.toByteArray());
+  } else if (mDirectory->fileExists(planesCacheFp)) {
+    mDirectory->removeFile(planesCacheFp);
+  }
 }
 
 void Board::selectAll() noexcept {
@@ -710,42 +834,46 @@ void Board::setSelectionRect(const Point& p1, const Point& p2,
   mGraphicsScene->setSelectionRect(p1, p2);
   if (updateItems) {
     QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+    // only items found in the spatial index need to be tested exactly
+    const QSet<BI_Base*> candidates = getItemsInRect(rectPx);
     foreach (BI_Device* device, mDeviceInstances) {
-      bool selectDevice = device->isSelectable() &&
+      bool selectDevice = candidates.contains(device) &&
+          device->isSelectable() &&
           device->getGrabAreaScenePx().intersects(rectPx);
       device->setSelected(selectDevice);
       foreach (BI_FootprintPad* pad, device->getPads()) {
-        bool selectPad =
-            pad->isSelectable() && pad->getGrabAreaScenePx().intersects(rectPx);
+        bool selectPad = candidates.contains(pad) && pad->isSelectable() &&
+            pad->getGrabAreaScenePx().intersects(rectPx);
         pad->setSelected(selectDevice || selectPad);
       }
       foreach (BI_StrokeText* text, device->getStrokeTexts()) {
-        bool selectText = text->isSelectable() &&
+        bool selectText = candidates.contains(text) && text->isSelectable() &&
             text->getGrabAreaScenePx().intersects(rectPx);
         text->setSelected(selectDevice || selectText);
       }
     }
     foreach (BI_NetSegment* segment, mNetSegments) {
-      segment->setSelectionRect(rectPx);
+      segment->setSelectionRect(rectPx, candidates);
     }
     foreach (BI_Plane* plane, mPlanes) {
-      bool select = plane->isSelectable() &&
+      bool select = candidates.contains(plane) && plane->isSelectable() &&
           plane->getGrabAreaScenePx().intersects(rectPx);
       plane->setSelected(select);
     }
     foreach (BI_Polygon* polygon, mPolygons) {
-      bool select = polygon->isSelectable() &&
+      bool select = candidates.contains(polygon) &&
+          polygon->isSelectable() &&
           polygon->getGrabAreaScenePx().intersects(rectPx);
       polygon->setSelected(select);
     }
     foreach (BI_StrokeText* text, mStrokeTexts) {
-      bool select =
-          text->isSelectable() && text->getGrabAreaScenePx().intersects(rectPx);
+      bool select = candidates.contains(text) && text->isSelectable() &&
+          text->getGrabAreaScenePx().intersects(rectPx);
       text->setSelected(select);
     }
     foreach (BI_Hole* hole, mHoles) {
-      bool select =
-          hole->isSelectable() && hole->getGrabAreaScenePx().intersects(rectPx);
+      bool select = candidates.contains(hole) && hole->isSelectable() &&
+          hole->getGrabAreaScenePx().intersects(rectPx);
       hole->setSelected(select);
     }
   }
@@ -793,6 +921,126 @@ QVector<const AttributeProvider*> Board::getAttributeProviderParents() const
  *  Private Methods
  ******************************************************************************/
 
+void Board::rebuildPlanes(const QList<BI_Plane*>& planes) noexcept {
+  QList<BI_Plane*> sortedPlanes = planes;
+  std::sort(sortedPlanes.begin(), sortedPlanes.end(),
+            [](const BI_Plane* p1, const BI_Plane* p2) {
+              return !(*p1 < *p2);
+            });  // sort by priority (highest priority first)
+
+  // Planes on different layers do not depend on each other, so each layer is
+  // built in a separate thread. Within a layer, the planes are built in order
+  // of priority because each plane subtracts the fragments of the planes with
+  // higher priority. Planes not passed to this method keep their current
+  // fragments. The board itself is not modified by the worker threads.
+  struct LayerPlanes {
+    QList<BI_Plane*> planes;
+    QHash<const BI_Plane*, QVector<Path>> fragments;
+  };
+  QMap<QString, LayerPlanes> layers;
+  foreach (BI_Plane* plane, sortedPlanes) {
+    layers[*plane->getLayerName()].planes.append(plane);
+  }
+  QVector<LayerPlanes> jobs = layers.values().toVector();
+  QtConcurrent::blockingMap(jobs, [](LayerPlanes& layer) {
+    foreach (BI_Plane* plane, layer.planes) {
+      BoardPlaneFragmentsBuilder builder(*plane, layer.fragments);
+      layer.fragments.insert(plane, builder.buildFragments());
+    }
+  });
+
+  // Apply the results in this thread since it updates the graphics items.
+  foreach (const LayerPlanes& layer, jobs) {
+    foreach (BI_Plane* plane, layer.planes) {
+      plane->setCalculatedFragments(layer.fragments.value(plane));
+    }
+  }
+}
+
+void Board::startAirWiresRebuild(bool async) noexcept {
+  // Abort a rebuild which is still running, its net signals are rebuilt
+  // again together with the newly scheduled ones.
+  if (mAirWiresRebuildAbortFlag) {
+    *mAirWiresRebuildAbortFlag = true;
+    mAirWiresRebuildAbortFlag.reset();
+  }
+  const QSet<NetSignal*> netsignals = mPendingNetSignalsForAirWireRebuild +
+      mScheduledNetSignalsForAirWireRebuild;
+  mPendingNetSignalsForAirWireRebuild.clear();
+  mScheduledNetSignalsForAirWireRebuild.clear();
+
+  // Take snapshots of the net signals in this thread since the board must not
+  // be accessed by the worker thread.
+  QHash<NetSignal*, BoardAirWiresBuilder::Snapshot> snapshots;
+  foreach (NetSignal* netsignal, netsignals) {
+    if (netsignal && netsignal->isAddedToCircuit()) {
+      BoardAirWiresBuilder builder(*this, *netsignal);
+      snapshots.insert(netsignal, builder.takeSnapshot());
+    }
+  }
+  auto abortFlag = std::make_shared<std::atomic<bool>>(false);
+  auto build = [snapshots, abortFlag]() {
+    AirWiresMap airwires;
+    for (auto it = snapshots.begin(); it != snapshots.end(); ++it) {
+      if (*abortFlag) break;
+      try {
+        airwires.insert(it.key(), BoardAirWiresBuilder::buildAirWires(*it));
+      } catch (const std::exception& e) {
+        qCritical() << "Failed to build airwires:" << e.what();
+      }
+    }
+    return airwires;
+  };
+
+  if (async) {
+    mPendingNetSignalsForAirWireRebuild = netsignals;
+    mAirWiresRebuildAbortFlag = abortFlag;
+    mAirWiresRebuildWatcher.setFuture(QtConcurrent::run(build));
+  } else {
+    applyAirWires(netsignals, build());
+  }
+}
+
+void Board::airWiresRebuildFinished() noexcept {
+  if ((!mAirWiresRebuildAbortFlag) || (*mAirWiresRebuildAbortFlag)) {
+    return;  // result is outdated
+  }
+  mAirWiresRebuildAbortFlag.reset();
+  const QSet<NetSignal*> netsignals = mPendingNetSignalsForAirWireRebuild;
+  mPendingNetSignalsForAirWireRebuild.clear();
+  if (mIsAddedToProject) {
+    applyAirWires(netsignals, mAirWiresRebuildWatcher.result());
+  } else {
+    mScheduledNetSignalsForAirWireRebuild.unite(netsignals);
+  }
+}
+
+void Board::applyAirWires(const QSet<NetSignal*>& netsignals,
+                          const AirWiresMap& airwires) noexcept {
+  try {
+    foreach (NetSignal* netsignal, netsignals) {
+      // remove old airwires
+      while (BI_AirWire* airWire = mAirWires.take(netsignal)) {
+        airWire->removeFromBoard();  // can throw
+        delete airWire;
+      }
+
+      // add new airwires
+      if (netsignal && netsignal->isAddedToCircuit()) {
+        foreach (const auto& points, airwires.value(netsignal)) {
+          QScopedPointer<BI_AirWire> airWire(
+              new BI_AirWire(*this, *netsignal, points.first, points.second));
+          airWire->addToBoard();  // can throw
+          mAirWires.insertMulti(netsignal, airWire.take());
+        }
+      }
+    }
+  } catch (const std::exception&
+               e) {  // std::exception because of the many std containers...
+    qCritical() << "Failed to build airwires:" << e.what();
+  }
+}
+
 void Board::updateErcMessages() noexcept {
   // type: UnplacedComponent (ComponentInstances without DeviceInstance)
   if (mIsAddedToProject) {
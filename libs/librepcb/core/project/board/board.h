@@ -29,12 +29,14 @@
 #include "../../types/elementname.h"
 #include "../../types/length.h"
 #include "../../types/lengthunit.h"
+#include "../../types/point.h"
 #include "../../types/uuid.h"
 #include "../erc/if_ercmsgprovider.h"
 
 #include <QtCore>
 #include <QtWidgets>
 
+#include <atomic>
 #include <memory>
 
 /*******************************************************************************
@@ -61,6 +63,7 @@ class BoardSelectionQuery;
 class GraphicsLayer;
 class GraphicsScene;
 class NetSignal;
+class Path;
 class Project;
 
 /*******************************************************************************
@@ -141,6 +144,7 @@ public:
       const Point& pos, const GraphicsLayer* layer = nullptr,
       const QSet<const NetSignal*>& netsignals = {}) const noexcept;
   QList<BI_Base*> getAllItems() const noexcept;
+  QSet<BI_Base*> getItemsInRect(const QRectF& rectPx) const noexcept;
 
   // Getters: Attributes
   const Uuid& getUuid() const noexcept { return mUuid; }
@@ -183,6 +187,10 @@ public:
   void addPlane(BI_Plane& plane);
   void removePlane(BI_Plane& plane);
   void rebuildAllPlanes() noexcept;
+  void rebuildPlanes(const QVector<Path>& affectedAreas) noexcept;
+  void restoreAllPlanes(const QHash<Uuid, QVector<Path>>& fragments,
+                        const QByteArray& inputHash) noexcept;
+  QByteArray calculatePlanesInputHash() const noexcept;
 
   // Polygon Methods
   const QMap<Uuid, BI_Polygon*>& getPolygons() const noexcept {
@@ -246,7 +254,14 @@ signals:
   void deviceRemoved(BI_Device& comp);
 
 private:
+  typedef QHash<NetSignal*, QVector<QPair<Point, Point>>> AirWiresMap;
+
   void updateErcMessages() noexcept;
+  void startAirWiresRebuild(bool async) noexcept;
+  void airWiresRebuildFinished() noexcept;
+  void applyAirWires(const QSet<NetSignal*>& netsignals,
+                     const AirWiresMap& airwires) noexcept;
+  void rebuildPlanes(const QList<BI_Plane*>& planes) noexcept;
 
   // General
   Project& mProject;  ///< A reference to the Project object (from the ctor)
@@ -260,6 +275,10 @@ private:
   QScopedPointer<BoardFabricationOutputSettings> mFabricationOutputSettings;
   QRectF mViewRect;
   QSet<NetSignal*> mScheduledNetSignalsForAirWireRebuild;
+  QSet<NetSignal*> mPendingNetSignalsForAirWireRebuild;  ///< Being built
+  std::shared_ptr<std::atomic<bool>> mAirWiresRebuildAbortFlag;
+  QFutureWatcher<AirWiresMap> mAirWiresRebuildWatcher;
+  QByteArray mPlanesInputHash;  ///< Inputs of the current plane fragments
 
   // Attributes
   Uuid mUuid;
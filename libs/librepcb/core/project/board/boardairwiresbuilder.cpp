@@ -23,6 +23,7 @@
 #include "boardairwiresbuilder.h"
 
 #include "../../algorithm/airwiresbuilder.h"
+#include "../../algorithm/pointgridindex.h"
 #include "../../graphics/graphicslayer.h"
 #include "../../library/pkg/footprintpad.h"
 #include "../circuit/circuit.h"
@@ -60,23 +61,21 @@ BoardAirWiresBuilder::~BoardAirWiresBuilder() noexcept {
  *  General Methods
  ******************************************************************************/
 
-QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
-  AirWiresBuilder builder;
-  QHash<int, std::pair<Point, QString>> pointLayerMap;  // ID -> (point, layer)
-  QHash<const BI_NetLineAnchor*, int> anchorMap;  // anchor -> ID
+BoardAirWiresBuilder::Snapshot BoardAirWiresBuilder::takeSnapshot() const
+    noexcept {
+  Snapshot snapshot;
+  QHash<const BI_NetLineAnchor*, int> anchorMap;  // anchor -> index
 
   // pads
   foreach (ComponentSignalInstance* cmpSig, mNetSignal.getComponentSignals()) {
     Q_ASSERT(cmpSig);
     foreach (BI_FootprintPad* pad, cmpSig->getRegisteredFootprintPads()) {
       if (&pad->getBoard() != &mBoard) continue;
-      const Point& pos = pad->getPosition();
-      int id = builder.addPoint(pos);
-      pointLayerMap[id] = std::make_pair(pos,
-                                         (pad->getLibPad().isTht())
-                                             ? QString()  // on all layers
-                                             : pad->getLayerName());
-      anchorMap[pad] = id;
+      anchorMap[pad] = snapshot.points.count();
+      snapshot.points.append(std::make_pair(pad->getPosition(),
+                                            (pad->getLibPad().isTht())
+                                                ? QString()  // on all layers
+                                                : pad->getLayerName()));
     }
   }
 
@@ -86,47 +85,69 @@ QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
     if (&netsegment->getBoard() != &mBoard) continue;
     foreach (const BI_Via* via, netsegment->getVias()) {
       Q_ASSERT(via);
-      const Point& pos = via->getPosition();
-      int id = builder.addPoint(pos);
-      pointLayerMap[id] = std::make_pair(pos, QString());  // on all layers
-      anchorMap[via] = id;
+      anchorMap[via] = snapshot.points.count();
+      snapshot.points.append(
+          std::make_pair(via->getPosition(), QString()));  // on all layers
     }
     foreach (const BI_NetPoint* netpoint, netsegment->getNetPoints()) {
       Q_ASSERT(netpoint);
       if (const GraphicsLayer* layer = netpoint->getLayerOfLines()) {
-        Point pos = netpoint->getPosition();
-        int id = builder.addPoint(pos);
-        pointLayerMap[id] = std::make_pair(pos, layer->getName());
-        anchorMap[netpoint] = id;
+        anchorMap[netpoint] = snapshot.points.count();
+        snapshot.points.append(
+            std::make_pair(netpoint->getPosition(), layer->getName()));
       }
     }
     foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
       Q_ASSERT(netline);
       Q_ASSERT(anchorMap.contains(&netline->getStartPoint()));
       Q_ASSERT(anchorMap.contains(&netline->getEndPoint()));
-      builder.addEdge(anchorMap[&netline->getStartPoint()],
-                      anchorMap[&netline->getEndPoint()]);
+      snapshot.edges.append(std::make_pair(anchorMap[&netline->getStartPoint()],
+                                           anchorMap[&netline->getEndPoint()]));
     }
   }
 
-  // determine connections made by planes
+  // planes
   foreach (const BI_Plane* plane, mNetSignal.getBoardPlanes()) {
     Q_ASSERT(plane);
     if (&plane->getBoard() != &mBoard) continue;
-    foreach (const Path& fragment, plane->getFragments()) {
+    snapshot.planes.append(
+        std::make_pair(*plane->getLayerName(), plane->getFragments()));
+  }
+
+  return snapshot;
+}
+
+QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
+  return buildAirWires(takeSnapshot());
+}
+
+QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires(
+    const Snapshot& snapshot) {
+  AirWiresBuilder builder;
+  QVector<Point> points;
+  points.reserve(snapshot.points.count());
+  QVector<int> ids;  // index -> ID
+  ids.reserve(snapshot.points.count());
+  for (const auto& point : snapshot.points) {
+    points.append(point.first);
+    ids.append(builder.addPoint(point.first));
+  }
+  for (const auto& edge : snapshot.edges) {
+    builder.addEdge(ids.at(edge.first), ids.at(edge.second));
+  }
+
+  // determine connections made by planes
+  const PointGridIndex index(points);
+  for (const auto& plane : snapshot.planes) {
+    foreach (const Path& fragment, plane.second) {
       int lastId = -1;
-      QHashIterator<int, std::pair<Point, QString>> i(pointLayerMap);
-      while (i.hasNext()) {
-        i.next();
-        const Point& pos = i.value().first;
-        const QString& pointLayer = i.value().second;
-        if (pointLayer.isNull() || (pointLayer == plane->getLayerName())) {
-          if (fragment.toQPainterPathPx().contains(pos.toPxQPointF())) {
-            if (lastId >= 0) {
-              builder.addEdge(lastId, i.key());
-            }
-            lastId = i.key();
+      foreach (int i, index.findPointsInArea(fragment)) {
+        const QString& pointLayer = snapshot.points.at(i).second;
+        if (pointLayer.isNull() || (pointLayer == plane.first)) {
+          if (lastId >= 0) {
+            builder.addEdge(lastId, ids.at(i));
           }
+          lastId = ids.at(i);
         }
       }
     }
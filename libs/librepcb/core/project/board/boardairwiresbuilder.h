@@ -23,6 +23,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../geometry/path.h"
 #include "../../types/point.h"
 
 #include <QtCore>
@@ -44,6 +45,20 @@ class NetSignal;
  */
 class BoardAirWiresBuilder final {
 public:
+  // Types
+
+  /**
+   * @brief Copy of all data of a net signal required to build its airwires
+   *
+   * Does not reference any board items, thus the airwires can be built from
+   * it in a worker thread while the board is being modified.
+   */
+  struct Snapshot {
+    QVector<std::pair<Point, QString>> points;  ///< Position & layer (null=all)
+    QVector<std::pair<int, int>> edges;  ///< Indices of connected points
+    QVector<std::pair<QString, QVector<Path>>> planes;  ///< Layer & fragments
+  };
+
   // Constructors / Destructor
   BoardAirWiresBuilder() = delete;
   BoardAirWiresBuilder(const BoardAirWiresBuilder& other) = delete;
@@ -51,7 +66,9 @@ public:
   ~BoardAirWiresBuilder() noexcept;
 
   // General Methods
+  Snapshot takeSnapshot() const noexcept;
   QVector<QPair<Point, Point>> buildAirWires() const;
+  static QVector<QPair<Point, Point>> buildAirWires(const Snapshot& snapshot);
 
   // Operator Overloadings
   BoardAirWiresBuilder& operator=(const BoardAirWiresBuilder& rhs) = delete;
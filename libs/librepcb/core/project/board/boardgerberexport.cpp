@@ -52,6 +52,7 @@
 #include "items/bi_stroketext.h"
 #include "items/bi_via.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -97,25 +98,88 @@ void BoardGerberExport::exportPcbLayers(
     const BoardFabricationOutputSettings& settings) const {
   mWrittenFiles.clear();
 
+  // Determine all output files in this thread because the attribute
+  // substitution of file paths depends on mCurrentInnerCopperLayer. The order
+  // of this list also defines the order of the written files.
+  struct Job {
+    FilePath filePath;
+    std::function<void(const FilePath&)> exportFunc;
+  };
+  QVector<Job> jobs;
+  auto addJob = [&](const QString& suffix,
+                    const std::function<void(const FilePath&)>& func) {
+    jobs.append(
+        Job{getOutputFilePath(settings.getOutputBasePath() % suffix), func});
+  };
   if (settings.getMergeDrillFiles()) {
-    exportDrills(settings);
+    addJob(settings.getSuffixDrills(),
+           [&](const FilePath& fp) { exportDrills(settings, fp); });
   } else {
-    exportDrillsNpth(settings);
-    exportDrillsPth(settings);
-  }
-  exportLayerBoardOutlines(settings);
-  exportLayerTopCopper(settings);
-  exportLayerInnerCopper(settings);
-  exportLayerBottomCopper(settings);
-  exportLayerTopSolderMask(settings);
-  exportLayerBottomSolderMask(settings);
-  exportLayerTopSilkscreen(settings);
-  exportLayerBottomSilkscreen(settings);
+    addJob(settings.getSuffixDrillsNpth(),
+           [&](const FilePath& fp) { exportDrillsNpth(settings, fp); });
+    addJob(settings.getSuffixDrillsPth(),
+           [&](const FilePath& fp) { exportDrillsPth(settings, fp); });
+  }
+  addJob(settings.getSuffixOutlines(),
+         [this](const FilePath& fp) { exportLayerBoardOutlines(fp); });
+  addJob(settings.getSuffixCopperTop(),
+         [this](const FilePath& fp) { exportLayerTopCopper(fp); });
+  for (int i = 1; i <= mBoard.getLayerStack().getInnerLayerCount(); ++i) {
+    mCurrentInnerCopperLayer = i;  // used for attribute provider
+    addJob(settings.getSuffixCopperInner(),
+           [this, i](const FilePath& fp) { exportLayerInnerCopper(i, fp); });
+  }
+  mCurrentInnerCopperLayer = 0;
+  addJob(settings.getSuffixCopperBot(),
+         [this](const FilePath& fp) { exportLayerBottomCopper(fp); });
+  addJob(settings.getSuffixSolderMaskTop(),
+         [this](const FilePath& fp) { exportLayerTopSolderMask(fp); });
+  addJob(settings.getSuffixSolderMaskBot(),
+         [this](const FilePath& fp) { exportLayerBottomSolderMask(fp); });
+  // don't create silkscreen files if no layers selected
+  if (!settings.getSilkscreenLayersTop().isEmpty()) {
+    addJob(settings.getSuffixSilkscreenTop(), [&](const FilePath& fp) {
+      exportLayerTopSilkscreen(settings.getSilkscreenLayersTop(), fp);
+    });
+  }
+  if (!settings.getSilkscreenLayersBot().isEmpty()) {
+    addJob(settings.getSuffixSilkscreenBot(), [&](const FilePath& fp) {
+      exportLayerBottomSilkscreen(settings.getSilkscreenLayersBot(), fp);
+    });
+  }
   if (settings.getEnableSolderPasteTop()) {
-    exportLayerTopSolderPaste(settings);
+    addJob(settings.getSuffixSolderPasteTop(),
+           [this](const FilePath& fp) { exportLayerTopSolderPaste(fp); });
   }
   if (settings.getEnableSolderPasteBot()) {
-    exportLayerBottomSolderPaste(settings);
+    addJob(settings.getSuffixSolderPasteBot(),
+           [this](const FilePath& fp) { exportLayerBottomSolderPaste(fp); });
+  }
+
+  // The stroke font is not thread-safe, thus all texts are stroked in advance.
+  mStrokeTextPaths.clear();
+  foreach (const BI_StrokeText* text, mBoard.getStrokeTexts()) {
+    mStrokeTextPaths.insert(text, text->generatePaths());
+  }
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    foreach (const BI_StrokeText* text, device->getStrokeTexts()) {
+      mStrokeTextPaths.insert(text, text->generatePaths());
+    }
+  }
+
+  // The layers do not depend on each other, so each file is generated in a
+  // separate thread. The board itself is not modified by the worker threads.
+  // If any of them fails, the first exception is rethrown here.
+  try {
+    QtConcurrent::blockingMap(
+        jobs, [](const Job& job) { job.exportFunc(job.filePath); });
+  } catch (...) {
+    mStrokeTextPaths.clear();
+    throw;
+  }
+  mStrokeTextPaths.clear();
+  foreach (const Job& job, jobs) {
+    mWrittenFiles.append(job.filePath);
   }
 }
 
@@ -233,8 +297,7 @@ void BoardGerberExport::exportComponentLayer(BoardSide side,
     }
   }
 
-  gen.generate();
-  gen.saveToFile(filePath);
+  gen.generateToFile(filePath);
   mWrittenFiles.append(filePath);
 }
 
@@ -261,23 +324,17 @@ QVector<const AttributeProvider*>
  ******************************************************************************/
 
 void BoardGerberExport::exportDrills(
-    const BoardFabricationOutputSettings& settings) const {
-  FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
-                                  settings.getSuffixDrills());
+    const BoardFabricationOutputSettings& settings, const FilePath& fp) const {
   std::unique_ptr<ExcellonGenerator> gen =
       BoardGerberExport::createExcellonGenerator(
           settings, ExcellonGenerator::Plating::Mixed);
   drawPthDrills(*gen);
   drawNpthDrills(*gen);
-  gen->generate();
-  gen->saveToFile(fp);
-  mWrittenFiles.append(fp);
+  gen->generateToFile(fp);
 }
 
 void BoardGerberExport::exportDrillsNpth(
-    const BoardFabricationOutputSettings& settings) const {
-  FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
-                                  settings.getSuffixDrillsNpth());
+    const BoardFabricationOutputSettings& settings, const FilePath& fp) const {
   std::unique_ptr<ExcellonGenerator> gen =
       BoardGerberExport::createExcellonGenerator(
           settings, ExcellonGenerator::Plating::No);
@@ -290,178 +347,113 @@ void BoardGerberExport::exportDrillsNpth(
   // https://github.com/LibrePCB/LibrePCB/issues/998. If the PCB manufacturer
   // doesn't support a separate NPTH file, the user shall enable the
   // "merge PTH and NPTH drills"  option.
-  gen->generate();
-  gen->saveToFile(fp);
-  mWrittenFiles.append(fp);
+  gen->generateToFile(fp);
 }
 
 void BoardGerberExport::exportDrillsPth(
-    const BoardFabricationOutputSettings& settings) const {
-  FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
-                                  settings.getSuffixDrillsPth());
+    const BoardFabricationOutputSettings& settings, const FilePath& fp) const {
   std::unique_ptr<ExcellonGenerator> gen =
       BoardGerberExport::createExcellonGenerator(
           settings, ExcellonGenerator::Plating::Yes);
   drawPthDrills(*gen);
-  gen->generate();
-  gen->saveToFile(fp);
-  mWrittenFiles.append(fp);
+  gen->generateToFile(fp);
 }
 
-void BoardGerberExport::exportLayerBoardOutlines(
-    const BoardFabricationOutputSettings& settings) const {
-  FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
-                                  settings.getSuffixOutlines());
+void BoardGerberExport::exportLayerBoardOutlines(const FilePath& fp) const {
   GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
                       mProject.getVersion());
   gen.setFileFunctionOutlines(false);
   drawLayer(gen, GraphicsLayer::sBoardOutlines);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  gen.generateToFile(fp);
 }
 
-void BoardGerberExport::exportLayerTopCopper(
-    const BoardFabricationOutputSettings& settings) const {
-  FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
-                                  settings.getSuffixCopperTop());
+void BoardGerberExport::exportLayerTopCopper(const FilePath& fp) const {
   GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
                       mProject.getVersion());
   gen.setFileFunctionCopper(1, GerberGenerator::CopperSide::Top,
                             GerberGenerator::Polarity::Positive);
   drawLayer(gen, GraphicsLayer::sTopCopper);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  gen.generateToFile(fp);
 }
 
-void BoardGerberExport::exportLayerBottomCopper(
-    const BoardFabricationOutputSettings& settings) const {
-  FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
-                                  settings.getSuffixCopperBot());
+void BoardGerberExport::exportLayerBottomCopper(const FilePath& fp) const {
   GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
                       mProject.getVersion());
   gen.setFileFunctionCopper(mBoard.getLayerStack().getInnerLayerCount() + 2,
                             GerberGenerator::CopperSide::Bottom,
                             GerberGenerator::Polarity::Positive);
   drawLayer(gen, GraphicsLayer::sBotCopper);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  gen.generateToFile(fp);
 }
 
-void BoardGerberExport::exportLayerInnerCopper(
-    const BoardFabricationOutputSettings& settings) const {
-  for (int i = 1; i <= mBoard.getLayerStack().getInnerLayerCount(); ++i) {
-    mCurrentInnerCopperLayer = i;  // used for attribute provider
-    FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
-                                    settings.getSuffixCopperInner());
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        mProject.getVersion());
-    gen.setFileFunctionCopper(i + 1, GerberGenerator::CopperSide::Inner,
-                              GerberGenerator::Polarity::Positive);
-    drawLayer(gen, GraphicsLayer::getInnerLayerName(i));
-    gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
-  }
-  mCurrentInnerCopperLayer = 0;
+void BoardGerberExport::exportLayerInnerCopper(int layer,
+                                               const FilePath& fp) const {
+  GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                      mProject.getVersion());
+  gen.setFileFunctionCopper(layer + 1, GerberGenerator::CopperSide::Inner,
+                            GerberGenerator::Polarity::Positive);
+  drawLayer(gen, GraphicsLayer::getInnerLayerName(layer));
+  gen.generateToFile(fp);
 }
 
-void BoardGerberExport::exportLayerTopSolderMask(
-    const BoardFabricationOutputSettings& settings) const {
-  FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
-                                  settings.getSuffixSolderMaskTop());
+void BoardGerberExport::exportLayerTopSolderMask(const FilePath& fp) const {
   GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
                       mProject.getVersion());
   gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Top,
                                 GerberGenerator::Polarity::Negative);
   drawLayer(gen, GraphicsLayer::sTopStopMask);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  gen.generateToFile(fp);
 }
 
-void BoardGerberExport::exportLayerBottomSolderMask(
-    const BoardFabricationOutputSettings& settings) const {
-  FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
-                                  settings.getSuffixSolderMaskBot());
+void BoardGerberExport::exportLayerBottomSolderMask(const FilePath& fp) const {
   GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
                       mProject.getVersion());
   gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Bottom,
                                 GerberGenerator::Polarity::Negative);
   drawLayer(gen, GraphicsLayer::sBotStopMask);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  gen.generateToFile(fp);
 }
 
-void BoardGerberExport::exportLayerTopSilkscreen(
-    const BoardFabricationOutputSettings& settings) const {
-  QStringList layers = settings.getSilkscreenLayersTop();
-  if (layers.count() >
-      0) {  // don't create silkscreen file if no layers selected
-    FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
-                                    settings.getSuffixSilkscreenTop());
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        mProject.getVersion());
-    gen.setFileFunctionLegend(GerberGenerator::BoardSide::Top,
-                              GerberGenerator::Polarity::Positive);
-    foreach (const QString& layer, layers) { drawLayer(gen, layer); }
-    gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
-    drawLayer(gen, GraphicsLayer::sTopStopMask);
-    gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
-  }
+void BoardGerberExport::exportLayerTopSilkscreen(const QStringList& layers,
+                                                 const FilePath& fp) const {
+  GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                      mProject.getVersion());
+  gen.setFileFunctionLegend(GerberGenerator::BoardSide::Top,
+                            GerberGenerator::Polarity::Positive);
+  foreach (const QString& layer, layers) { drawLayer(gen, layer); }
+  gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
+  drawLayer(gen, GraphicsLayer::sTopStopMask);
+  gen.generateToFile(fp);
 }
 
-void BoardGerberExport::exportLayerBottomSilkscreen(
-    const BoardFabricationOutputSettings& settings) const {
-  QStringList layers = settings.getSilkscreenLayersBot();
-  if (layers.count() >
-      0) {  // don't create silkscreen file if no layers selected
-    FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
-                                    settings.getSuffixSilkscreenBot());
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        mProject.getVersion());
-    gen.setFileFunctionLegend(GerberGenerator::BoardSide::Bottom,
-                              GerberGenerator::Polarity::Positive);
-    foreach (const QString& layer, layers) { drawLayer(gen, layer); }
-    gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
-    drawLayer(gen, GraphicsLayer::sBotStopMask);
-    gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
-  }
+void BoardGerberExport::exportLayerBottomSilkscreen(const QStringList& layers,
+                                                    const FilePath& fp) const {
+  GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                      mProject.getVersion());
+  gen.setFileFunctionLegend(GerberGenerator::BoardSide::Bottom,
+                            GerberGenerator::Polarity::Positive);
+  foreach (const QString& layer, layers) { drawLayer(gen, layer); }
+  gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
+  drawLayer(gen, GraphicsLayer::sBotStopMask);
+  gen.generateToFile(fp);
 }
 
-void BoardGerberExport::exportLayerTopSolderPaste(
-    const BoardFabricationOutputSettings& settings) const {
-  FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
-                                  settings.getSuffixSolderPasteTop());
+void BoardGerberExport::exportLayerTopSolderPaste(const FilePath& fp) const {
   GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
                       mProject.getVersion());
   gen.setFileFunctionPaste(GerberGenerator::BoardSide::Top,
                            GerberGenerator::Polarity::Positive);
   drawLayer(gen, GraphicsLayer::sTopSolderPaste);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  gen.generateToFile(fp);
 }
 
-void BoardGerberExport::exportLayerBottomSolderPaste(
-    const BoardFabricationOutputSettings& settings) const {
-  FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
-                                  settings.getSuffixSolderPasteBot());
+void BoardGerberExport::exportLayerBottomSolderPaste(const FilePath& fp) const {
   GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
                       mProject.getVersion());
   gen.setFileFunctionPaste(GerberGenerator::BoardSide::Bottom,
                            GerberGenerator::Polarity::Positive);
   drawLayer(gen, GraphicsLayer::sBotSolderPaste);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  gen.generateToFile(fp);
 }
 
 int BoardGerberExport::drawNpthDrills(ExcellonGenerator& gen) const {
@@ -595,7 +587,7 @@ void BoardGerberExport::drawLayer(GerberGenerator& gen,
       UnsignedLength lineWidth =
           calcWidthOfLayer(text->getText().getStrokeWidth(), layerName);
       const Transform transform(text->getText());
-      foreach (Path path, transform.map(text->generatePaths())) {
+      foreach (Path path, transform.map(getStrokeTextPaths(*text))) {
         gen.drawPathOutline(path, lineWidth, textFunction, graphicsNet,
                             QString());
       }
@@ -696,7 +688,7 @@ void BoardGerberExport::drawDevice(GerberGenerator& gen,
       UnsignedLength lineWidth =
           calcWidthOfLayer(text->getText().getStrokeWidth(), layerName);
       Transform transform(text->getText());
-      foreach (Path path, transform.map(text->generatePaths())) {
+      foreach (Path path, transform.map(getStrokeTextPaths(*text))) {
         gen.drawPathOutline(path, lineWidth, textFunction, graphicsNet,
                             component);
       }
@@ -816,6 +808,16 @@ std::unique_ptr<ExcellonGenerator> BoardGerberExport::createExcellonGenerator(
   return gen;
 }
 
+QVector<Path> BoardGerberExport::getStrokeTextPaths(
+    const BI_StrokeText& text) const noexcept {
+  auto it = mStrokeTextPaths.constFind(&text);
+  if (it != mStrokeTextPaths.constEnd()) {
+    return *it;
+  } else {
+    return text.generatePaths();
+  }
+}
+
 FilePath BoardGerberExport::getOutputFilePath(QString path) const noexcept {
   path = AttributeSubstitutor::substitute(path, this, [&](const QString& str) {
     return FilePath::cleanFileName(
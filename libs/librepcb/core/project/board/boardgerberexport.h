@@ -39,6 +39,7 @@ namespace librepcb {
 
 class BI_Device;
 class BI_FootprintPad;
+class BI_StrokeText;
 class BI_Via;
 class Board;
 class BoardFabricationOutputSettings;
@@ -92,29 +93,24 @@ signals:
 
 private:
   // Private Methods
-  void exportDrills(const BoardFabricationOutputSettings& settings) const;
-  void exportDrillsNpth(const BoardFabricationOutputSettings& settings) const;
-  void exportDrillsPth(const BoardFabricationOutputSettings& settings) const;
-  void exportLayerBoardOutlines(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopCopper(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerInnerCopper(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerBottomCopper(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopSolderMask(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerBottomSolderMask(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopSilkscreen(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerBottomSilkscreen(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopSolderPaste(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerBottomSolderPaste(
-      const BoardFabricationOutputSettings& settings) const;
+  void exportDrills(const BoardFabricationOutputSettings& settings,
+                    const FilePath& fp) const;
+  void exportDrillsNpth(const BoardFabricationOutputSettings& settings,
+                        const FilePath& fp) const;
+  void exportDrillsPth(const BoardFabricationOutputSettings& settings,
+                       const FilePath& fp) const;
+  void exportLayerBoardOutlines(const FilePath& fp) const;
+  void exportLayerTopCopper(const FilePath& fp) const;
+  void exportLayerInnerCopper(int layer, const FilePath& fp) const;
+  void exportLayerBottomCopper(const FilePath& fp) const;
+  void exportLayerTopSolderMask(const FilePath& fp) const;
+  void exportLayerBottomSolderMask(const FilePath& fp) const;
+  void exportLayerTopSilkscreen(const QStringList& layers,
+                                const FilePath& fp) const;
+  void exportLayerBottomSilkscreen(const QStringList& layers,
+                                   const FilePath& fp) const;
+  void exportLayerTopSolderPaste(const FilePath& fp) const;
+  void exportLayerBottomSolderPaste(const FilePath& fp) const;
 
   int drawNpthDrills(ExcellonGenerator& gen) const;
   int drawPthDrills(ExcellonGenerator& gen) const;
@@ -129,6 +125,7 @@ private:
   std::unique_ptr<ExcellonGenerator> createExcellonGenerator(
       const BoardFabricationOutputSettings& settings,
       ExcellonGenerator::Plating plating) const;
+  QVector<Path> getStrokeTextPaths(const BI_StrokeText& text) const noexcept;
   FilePath getOutputFilePath(QString path) const noexcept;
 
   // Static Methods
@@ -142,6 +139,10 @@ private:
   QString mProjectName;
   mutable int mCurrentInnerCopperLayer;
   mutable QVector<FilePath> mWrittenFiles;
+
+  /// Stroke texts generated in advance since the stroke font is not
+  /// thread-safe (only valid during #exportPcbLayers())
+  mutable QHash<const BI_StrokeText*, QVector<Path>> mStrokeTextPaths;
 };
 
 /*******************************************************************************
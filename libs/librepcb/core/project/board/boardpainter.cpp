@@ -26,6 +26,7 @@
 #include "../../attribute/attributesubstitutor.h"
 #include "../../export/graphicsexportsettings.h"
 #include "../../font/strokefontpool.h"
+#include "../../geometry/padgeometrycache.h"
 #include "../../geometry/text.h"
 #include "../../graphics/graphicslayer.h"
 #include "../../graphics/graphicspainter.h"
@@ -249,8 +250,10 @@ void BoardPainter::initContentByLayer() const noexcept {
       // Footprint pads.
       foreach (const Pad& pad, footprint.pads) {
         foreach (const auto& layerGeometry, pad.layerGeometries) {
-          const QPainterPath path = footprint.transform.mapPx(
-              pad.transform.mapPx(layerGeometry.second.toQPainterPathPx()));
+          const QPainterPath path =
+              footprint.transform.mapPx(pad.transform.mapPx(
+                  PadGeometryCache::instance().getQPainterPathPx(
+                      layerGeometry.second)));
           if ((!pad.holes.isEmpty()) &&
               GraphicsLayer::isCopperLayer(layerGeometry.first)) {
             LayerContent& tht = mContentByLayer[GraphicsLayer::sBoardPadsTht];
@@ -48,8 +48,10 @@ namespace librepcb {
  *  Constructors / Destructor
  ******************************************************************************/
 
-BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept
-  : mPlane(plane) {
+BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(
+    BI_Plane& plane,
+    const QHash<const BI_Plane*, QVector<Path>>& otherFragments) noexcept
+  : mPlane(plane), mOtherFragments(otherFragments) {
 }
 
 BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept {
@@ -137,8 +139,12 @@ void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
     if (*plane < mPlane) continue;  // ignore planes with lower priority
     if (plane->getLayerName() != mPlane.getLayerName()) continue;
     if (&plane->getNetSignal() == &mPlane.getNetSignal()) continue;
+    const auto it = mOtherFragments.constFind(plane);
+    const QVector<Path>& fragments = (it != mOtherFragments.constEnd())
+        ? it.value()
+        : plane->getFragments();
     ClipperLib::Paths paths =
-        ClipperHelpers::convert(plane->getFragments(), maxArcTolerance());
+        ClipperHelpers::convert(fragments, maxArcTolerance());
     ClipperHelpers::offset(paths, *mPlane.getMinClearance(),
                            maxArcTolerance());  // can throw
     c.AddPaths(paths, ClipperLib::ptClip, true);
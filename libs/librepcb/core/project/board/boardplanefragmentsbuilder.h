@@ -51,7 +51,21 @@ public:
   // Constructors / Destructor
   BoardPlaneFragmentsBuilder() = delete;
   BoardPlaneFragmentsBuilder(const BoardPlaneFragmentsBuilder& other) = delete;
-  BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept;
+  /**
+   * @brief Constructor
+   *
+   * @param plane               The plane to build the fragments of.
+   * @param otherFragments      Already calculated fragments of other planes
+   *                            which are not applied to the planes yet. They
+   *                            are used instead of the fragments currently
+   *                            set in those planes. This allows to build the
+   *                            fragments in a worker thread without modifying
+   *                            the board.
+   */
+  BoardPlaneFragmentsBuilder(
+      BI_Plane& plane,
+      const QHash<const BI_Plane*, QVector<Path>>& otherFragments =
+          QHash<const BI_Plane*, QVector<Path>>()) noexcept;
   ~BoardPlaneFragmentsBuilder() noexcept;
 
   // General Methods
@@ -86,6 +100,7 @@ private:  // Methods
 
 private:  // Data
   BI_Plane& mPlane;
+  QHash<const BI_Plane*, QVector<Path>> mOtherFragments;
   ClipperLib::Paths mConnectedNetSignalAreas;
   ClipperLib::Paths mResult;
 };
@@ -47,6 +47,7 @@
 #include "../items/bi_via.h"
 #include "boardclipperpathgenerator.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -80,6 +81,9 @@ void BoardDesignRuleCheck::execute() {
 
   mProgressStatus.clear();
   mMessages.clear();
+  if (mCache) {
+    mCache->mReusedAreas = 0;
+  }
 
   if (mOptions.rebuildPlanes) {
     rebuildPlanes(5, 15);
@@ -165,11 +169,6 @@ void BoardDesignRuleCheck::checkCopperBoardClearances(int progressStart,
                                                       int progressEnd) {
   emitStatus(tr("Check board clearances..."));
 
-  qreal progressSpan = progressEnd - progressStart;
-  QList<NetSignal*> netsignals =
-      mBoard.getProject().getCircuit().getNetSignals().values();
-  netsignals.append(nullptr);  // also check unconnected copper objects
-
   // Board outline
   ClipperLib::Paths outlineRestrictedArea;
   if (mOptions.checkCopperBoardClearance) {
@@ -190,79 +189,126 @@ void BoardDesignRuleCheck::checkCopperBoardClearances(int progressStart,
     gen.addHoles(*mOptions.minCopperNpthClearance - *maxArcTolerance());
     ClipperHelpers::unite(outlineRestrictedArea, gen.getPaths());
   }
-
-  auto layers = mBoard.getLayerStack().getAllLayers();
-  for (int layerIndex = 0; layerIndex < layers.count(); ++layerIndex) {
-    const GraphicsLayer* layer = layers[layerIndex];
-    if ((!layer->isCopperLayer()) || (!layer->isEnabled())) {
-      continue;
+  emit progressPercent(progressStart + (progressEnd - progressStart) / 3);
+
+  // If the restricted area has changed, all areas need to be checked again.
+  CachedCheck* cache = mCache ? &mCache->mBoardClearances : nullptr;
+  if (cache && (cache->restrictedArea != outlineRestrictedArea)) {
+    cache->areas.clear();
+  }
+
+  // Check the copper of each net on each layer in parallel.
+  QHash<QPair<CacheKey, CacheKey>, QList<BoardDesignRuleCheckMessage>>
+      cachedMessages;
+  if (cache) {
+    cachedMessages = cache->messages;
+  }
+  QVector<CopperArea> areas = getCopperAreas(Length(0), cache);
+  const QString msgTr = tr("Clearance (%1): '%2' <-> Board Outline",
+                           "Placeholders are layer name + net name");
+  QtConcurrent::blockingMap(areas, [&](CopperArea& area) {
+    const QPair<CacheKey, CacheKey> key(CacheKey(area.layer, area.netSignal),
+                                        CacheKey());
+    if ((!area.changed) && cachedMessages.contains(key)) {
+      area.messages = cachedMessages.value(key);
+      return;
     }
-    for (int i = 0; i < netsignals.count(); ++i) {
-      std::unique_ptr<ClipperLib::PolyTree> intersections =
-          ClipperHelpers::intersect(outlineRestrictedArea,
-                                    getCopperPaths(*layer, {netsignals[i]}));
-      for (const ClipperLib::Path& path :
-           ClipperHelpers::flattenTree(*intersections)) {
-        QString name1 = netsignals[i] ? *netsignals[i]->getName() : "";
-        QString msg = tr("Clearance (%1): '%2' <-> Board Outline",
-                         "Placeholders are layer name + net name")
-                          .arg(layer->getNameTr(), name1);
-        Path location = ClipperHelpers::convert(path);
-        emitMessage(BoardDesignRuleCheckMessage(msg, location));
-      }
-      qreal progress = progressSpan *
-          qreal((layerIndex + 1) * netsignals.count() + i + 1) /
-          qreal(layers.count() * netsignals.count());
-      emit progressPercent(progressStart + static_cast<int>(progress));
+    std::unique_ptr<ClipperLib::PolyTree> intersections =
+        ClipperHelpers::intersect(outlineRestrictedArea, area.paths);
+    for (const ClipperLib::Path& path :
+         ClipperHelpers::flattenTree(*intersections)) {
+      QString name1 = area.netSignal ? *area.netSignal->getName() : "";
+      QString msg = msgTr.arg(area.layer->getNameTr(), name1);
+      Path location = ClipperHelpers::convert(path);
+      area.messages.append(BoardDesignRuleCheckMessage(msg, location));
+    }
+  });
+  if (cache) {
+    cache->restrictedArea = outlineRestrictedArea;
+  }
+  foreach (const CopperArea& area, areas) {
+    if (cache) {
+      cache->messages.insert(
+          qMakePair(CacheKey(area.layer, area.netSignal), CacheKey()),
+          area.messages);
+    }
+    foreach (const BoardDesignRuleCheckMessage& msg, area.messages) {
+      emitMessage(msg);
     }
   }
+  emit progressPercent(progressEnd);
 }
 
 void BoardDesignRuleCheck::checkCopperCopperClearances(int progressStart,
                                                        int progressEnd) {
   emitStatus(tr("Check copper clearances..."));
 
-  qreal progressSpan = progressEnd - progressStart;
-  QList<NetSignal*> netsignals =
-      mBoard.getProject().getCircuit().getNetSignals().values();
-  netsignals.append(nullptr);  // also check unconnected copper objects
-
-  auto layers = mBoard.getLayerStack().getAllLayers();
-  for (int layerIndex = 0; layerIndex < layers.count(); ++layerIndex) {
-    const GraphicsLayer* layer = layers[layerIndex];
-    if ((!layer->isCopperLayer()) || (!layer->isEnabled())) {
-      continue;
+  // Offset the copper of each net only once, instead of once per pair of nets.
+  CachedCheck* cache = mCache ? &mCache->mCopperClearances : nullptr;
+  QHash<QPair<CacheKey, CacheKey>, QList<BoardDesignRuleCheckMessage>>
+      cachedMessages;
+  if (cache) {
+    cachedMessages = cache->messages;
+  }
+  QVector<CopperArea> areas = getCopperAreas(
+      (*mOptions.minCopperCopperClearance - *maxArcTolerance()) / 2, cache);
+  emit progressPercent(progressStart + (progressEnd - progressStart) / 3);
+
+  // Broad phase: Only nets on the same layer with overlapping bounding boxes
+  // can violate the clearance. The areas are sorted by layer.
+  for (int begin = 0; begin < areas.count();) {
+    int end = begin + 1;
+    while ((end < areas.count()) &&
+           (areas.at(end).layer == areas.at(begin).layer)) {
+      ++end;
     }
-    for (int i = 0; i < netsignals.count(); ++i) {
-      ClipperLib::Paths paths1 = getCopperPaths(*layer, {netsignals[i]});
-      ClipperHelpers::offset(
-          paths1, (*mOptions.minCopperCopperClearance - *maxArcTolerance()) / 2,
-          maxArcTolerance());
-      for (int k = i + 1; k < netsignals.count(); ++k) {
-        ClipperLib::Paths paths2 = getCopperPaths(*layer, {netsignals[k]});
-        ClipperHelpers::offset(
-            paths2,
-            (*mOptions.minCopperCopperClearance - *maxArcTolerance()) / 2,
-            maxArcTolerance());
-        std::unique_ptr<ClipperLib::PolyTree> intersections =
-            ClipperHelpers::intersect(paths1, paths2);
-        for (const ClipperLib::Path& path :
-             ClipperHelpers::flattenTree(*intersections)) {
-          QString name1 = netsignals[i] ? *netsignals[i]->getName() : "";
-          QString name2 = netsignals[k] ? *netsignals[k]->getName() : "";
-          QString msg = tr("Clearance (%1): '%2' <-> '%3'",
-                           "Placeholders are layer name + net names")
-                            .arg(layer->getNameTr(), name1, name2);
-          Path location = ClipperHelpers::convert(path);
-          emitMessage(BoardDesignRuleCheckMessage(msg, location));
-        }
+    findCandidates(areas, begin, end);
+    begin = end;
+  }
+
+  // Check each net against its candidates in parallel. Pairs of unchanged
+  // areas are taken from the cache. The messages are kept per candidate to
+  // get a deterministic order independent of the thread scheduling.
+  const QString msgTr = tr("Clearance (%1): '%2' <-> '%3'",
+                           "Placeholders are layer name + net names");
+  QtConcurrent::blockingMap(areas, [&](CopperArea& area1) {
+    for (Candidate& candidate : area1.candidates) {
+      const CopperArea& area2 = areas.at(candidate.index);
+      const QPair<CacheKey, CacheKey> key(
+          CacheKey(area1.layer, area1.netSignal),
+          CacheKey(area2.layer, area2.netSignal));
+      if ((!area1.changed) && (!area2.changed) &&
+          cachedMessages.contains(key)) {
+        candidate.messages = cachedMessages.value(key);
+        continue;
+      }
+      std::unique_ptr<ClipperLib::PolyTree> intersections =
+          ClipperHelpers::intersect(area1.paths, area2.paths);
+      for (const ClipperLib::Path& path :
+           ClipperHelpers::flattenTree(*intersections)) {
+        QString name1 = area1.netSignal ? *area1.netSignal->getName() : "";
+        QString name2 = area2.netSignal ? *area2.netSignal->getName() : "";
+        QString msg = msgTr.arg(area1.layer->getNameTr(), name1, name2);
+        Path location = ClipperHelpers::convert(path);
+        candidate.messages.append(BoardDesignRuleCheckMessage(msg, location));
+      }
+    }
+  });
+  foreach (const CopperArea& area1, areas) {
+    foreach (const Candidate& candidate, area1.candidates) {
+      if (cache) {
+        const CopperArea& area2 = areas.at(candidate.index);
+        cache->messages.insert(
+            qMakePair(CacheKey(area1.layer, area1.netSignal),
+                      CacheKey(area2.layer, area2.netSignal)),
+            candidate.messages);
+      }
+      foreach (const BoardDesignRuleCheckMessage& msg, candidate.messages) {
+        emitMessage(msg);
       }
-      qreal progress = progressSpan *
-          qreal((layerIndex + 1) * netsignals.count() + i + 1) /
-          qreal(layers.count() * netsignals.count());
-      emit progressPercent(progressStart + static_cast<int>(progress));
     }
   }
+  emit progressPercent(progressEnd);
 }
 
 void BoardDesignRuleCheck::checkCourtyardClearances(int progressStart,
@@ -270,38 +316,96 @@ void BoardDesignRuleCheck::checkCourtyardClearances(int progressStart,
   Q_UNUSED(progressStart);
   emitStatus(tr("Check courtyard clearances..."));
 
+  // If the offset has changed, all areas need to be checked again.
+  CachedCheck* cache = mCache ? &mCache->mCourtyardClearances : nullptr;
+  QHash<CacheKey, CachedArea> cachedAreas;
+  QHash<QPair<CacheKey, CacheKey>, QList<BoardDesignRuleCheckMessage>>
+      cachedMessages;
+  if (cache && (cache->offset == mOptions.courtyardOffset)) {
+    cachedAreas = cache->areas;
+    cachedMessages = cache->messages;
+  }
+  if (cache) {
+    cache->offset = mOptions.courtyardOffset;
+    cache->areas.clear();
+    cache->messages.clear();
+  }
+
+  const QString msgTr = tr("Clearance (%1): '%2' <-> '%3'",
+                           "Placeholders are layer name + component names");
   auto layers = mBoard.getLayerStack().getLayers(
       {GraphicsLayer::sTopCourtyard, GraphicsLayer::sBotCourtyard});
   foreach (const GraphicsLayer* layer, layers) {
     // determine device courtyard areas
-    QMap<const BI_Device*, ClipperLib::Paths> deviceCourtyards;
+    QVector<CourtyardArea> areas;
     foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-      ClipperLib::Paths paths = getDeviceCourtyardPaths(*device, layer);
-      ClipperHelpers::offset(paths, mOptions.courtyardOffset,
-                             maxArcTolerance());
-      deviceCourtyards.insert(device, paths);
+      const ClipperLib::Paths rawPaths =
+          getDeviceCourtyardPaths(*device, layer);
+      CourtyardArea area{layer, device, rawPaths, {}, true, {}};
+      const CacheKey key(layer, device);
+      const QString name = *device->getComponentInstance().getName();
+      if (cache) {
+        cache->areas.insert(key, CachedArea{name, rawPaths, {}});
+      }
+      auto it = cachedAreas.constFind(key);
+      if ((it != cachedAreas.constEnd()) && (it->name == name) &&
+          (it->paths == rawPaths)) {
+        area.paths = it->offsetPaths;
+        area.changed = false;
+        ++mCache->mReusedAreas;
+      }
+      areas.append(area);
     }
+    QtConcurrent::blockingMap(areas, [this](CourtyardArea& area) {
+      if (area.changed) {
+        ClipperHelpers::offset(area.paths, mOptions.courtyardOffset,
+                               maxArcTolerance());
+      }
+      area.bounds = ClipperHelpers::getBounds(area.paths);
+    });
 
-    // check clearances
-    for (int i = 0; i < deviceCourtyards.count(); ++i) {
-      const BI_Device* dev1 = deviceCourtyards.keys()[i];
+    // check clearances (only of devices with overlapping bounding boxes)
+    findCandidates(areas, 0, areas.count());
+    QtConcurrent::blockingMap(areas, [&](CourtyardArea& area1) {
+      const BI_Device* dev1 = area1.device;
       Q_ASSERT(dev1);
-      const ClipperLib::Paths& paths1 = deviceCourtyards[dev1];
-      for (int k = i + 1; k < deviceCourtyards.count(); ++k) {
-        const BI_Device* dev2 = deviceCourtyards.keys()[k];
+      for (Candidate& candidate : area1.candidates) {
+        const CourtyardArea& area2 = areas.at(candidate.index);
+        const BI_Device* dev2 = area2.device;
         Q_ASSERT(dev2);
-        const ClipperLib::Paths& paths2 = deviceCourtyards[dev2];
+        const QPair<CacheKey, CacheKey> key(CacheKey(layer, dev1),
+                                            CacheKey(layer, dev2));
+        if ((!area1.changed) && (!area2.changed) &&
+            cachedMessages.contains(key)) {
+          candidate.messages = cachedMessages.value(key);
+          continue;
+        }
         std::unique_ptr<ClipperLib::PolyTree> intersections =
-            ClipperHelpers::intersect(paths1, paths2);
+            ClipperHelpers::intersect(area1.paths, area2.paths);
         for (const ClipperLib::Path& path :
              ClipperHelpers::flattenTree(*intersections)) {
           QString name1 = *dev1->getComponentInstance().getName();
           QString name2 = *dev2->getComponentInstance().getName();
-          QString msg = tr("Clearance (%1): '%2' <-> '%3'",
-                           "Placeholders are layer name + component names")
-                            .arg(layer->getNameTr(), name1, name2);
+          QString msg = msgTr.arg(layer->getNameTr(), name1, name2);
           Path location = ClipperHelpers::convert(path);
-          emitMessage(BoardDesignRuleCheckMessage(msg, location));
+          candidate.messages.append(
+              BoardDesignRuleCheckMessage(msg, location));
+        }
+      }
+    });
+    foreach (const CourtyardArea& area1, areas) {
+      if (cache) {
+        cache->areas[CacheKey(layer, area1.device)].offsetPaths = area1.paths;
+      }
+      foreach (const Candidate& candidate, area1.candidates) {
+        if (cache) {
+          cache->messages.insert(
+              qMakePair(CacheKey(layer, area1.device),
+                        CacheKey(layer, areas.at(candidate.index).device)),
+              candidate.messages);
+        }
+        foreach (const BoardDesignRuleCheckMessage& msg, candidate.messages) {
+          emitMessage(msg);
         }
       }
     }
@@ -421,10 +525,18 @@ void BoardDesignRuleCheck::checkMinimumPthAnnularRing(int progressStart,
   const ClipperLib::Paths thtCopperAreaPaths =
       ClipperHelpers::treeToPaths(*thtCopperAreaIntersections);
 
-  // Check via annular rings.
+  // Determine the via/pad areas including minimum annular ring. The messages
+  // are prepared here, the (expensive) subtraction is done in parallel.
+  struct Ring {
+    ClipperLib::Paths areas;
+    QString msg;
+    ClipperLib::Paths remainingAreas;
+  };
+  QVector<Ring> rings;
+
+  // Vias.
   foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
     foreach (const BI_Via* via, netsegment->getVias()) {
-      // Determine via area including minimum annular ring.
       const Length diameter =
           via->getDrillDiameter() + (*mOptions.minPthAnnularRing * 2) - 1;
       if (diameter <= 0) {
@@ -433,27 +545,17 @@ void BoardDesignRuleCheck::checkMinimumPthAnnularRing(int progressStart,
       const ClipperLib::Paths areas{ClipperHelpers::convert(
           Path::circle(PositiveLength(diameter)).translated(via->getPosition()),
           maxArcTolerance())};
-
-      // Check if there's not a 100% overlap.
-      const std::unique_ptr<ClipperLib::PolyTree> remainingAreasTree =
-          ClipperHelpers::subtractToTree(areas, thtCopperAreaPaths);
-      const ClipperLib::Paths remainingAreas =
-          ClipperHelpers::flattenTree(*remainingAreasTree);
-      if (!remainingAreas.empty()) {
-        QString msg = tr("Annular ring of via '%1' < %2",
-                         "Placeholders are net name + annular ring width")
-                          .arg(netsegment->getNetNameToDisplay(true),
-                               formatLength(*mOptions.minPthAnnularRing));
-        const QVector<Path> location = ClipperHelpers::convert(remainingAreas);
-        emitMessage(BoardDesignRuleCheckMessage(msg, location));
-      }
+      QString msg = tr("Annular ring of via '%1' < %2",
+                       "Placeholders are net name + annular ring width")
+                        .arg(netsegment->getNetNameToDisplay(true),
+                             formatLength(*mOptions.minPthAnnularRing));
+      rings.append(Ring{areas, msg, {}});
     }
   }
 
-  // Check pad annular rings.
+  // Pads.
   foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
     foreach (const BI_FootprintPad* pad, device->getPads()) {
-      // Determine hole areas including minimum annular ring.
       const Transform transform(*pad);
       ClipperLib::Paths areas;
       for (const Hole& hole : pad->getLibPad().getHoles()) {
@@ -469,20 +571,25 @@ void BoardDesignRuleCheck::checkMinimumPthAnnularRing(int progressStart,
               ClipperHelpers::convert(transform.map(area), maxArcTolerance()));
         }
       }
+      QString msg = tr("Annular ring of pad '%1' < %2",
+                       "Placeholders are pad name + annular ring width")
+                        .arg(pad->getDisplayText().simplified(),
+                             formatLength(*mOptions.minPthAnnularRing));
+      rings.append(Ring{areas, msg, {}});
+    }
+  }
 
-      // Check if there's not a 100% overlap.
-      const std::unique_ptr<ClipperLib::PolyTree> remainingAreasTree =
-          ClipperHelpers::subtractToTree(areas, thtCopperAreaPaths);
-      const ClipperLib::Paths remainingAreas =
-          ClipperHelpers::flattenTree(*remainingAreasTree);
-      if (!remainingAreas.empty()) {
-        QString msg = tr("Annular ring of pad '%1' < %2",
-                         "Placeholders are pad name + annular ring width")
-                          .arg(pad->getDisplayText().simplified(),
-                               formatLength(*mOptions.minPthAnnularRing));
-        const QVector<Path> location = ClipperHelpers::convert(remainingAreas);
-        emitMessage(BoardDesignRuleCheckMessage(msg, location));
-      }
+  // Check if there's not a 100% overlap.
+  QtConcurrent::blockingMap(rings, [&thtCopperAreaPaths](Ring& ring) {
+    const std::unique_ptr<ClipperLib::PolyTree> remainingAreasTree =
+        ClipperHelpers::subtractToTree(ring.areas, thtCopperAreaPaths);
+    ring.remainingAreas = ClipperHelpers::flattenTree(*remainingAreasTree);
+  });
+  foreach (const Ring& ring, rings) {
+    if (!ring.remainingAreas.empty()) {
+      const QVector<Path> location =
+          ClipperHelpers::convert(ring.remainingAreas);
+      emitMessage(BoardDesignRuleCheckMessage(ring.msg, location));
     }
   }
 
@@ -762,6 +869,86 @@ const ClipperLib::Paths& BoardDesignRuleCheck::getCopperPaths(
   return mCachedPaths[key];
 }
 
+QVector<BoardDesignRuleCheck::CopperArea>
+    BoardDesignRuleCheck::getCopperAreas(const Length& offset,
+                                         CachedCheck* cache) {
+  QList<NetSignal*> netsignals =
+      mBoard.getProject().getCircuit().getNetSignals().values();
+  netsignals.append(nullptr);  // also check unconnected copper objects
+
+  // If the offset has changed, all cached areas are invalid.
+  QHash<CacheKey, CachedArea> cachedAreas;
+  if (cache && (cache->offset == offset)) {
+    cachedAreas = cache->areas;
+  }
+  if (cache) {
+    // Messages must be taken from the cache by the caller *before* calling
+    // this method, the cached messages are invalid after the areas have been
+    // updated (e.g. if the check is aborted by an exception).
+    cache->offset = offset;
+    cache->areas.clear();
+    cache->messages.clear();
+  }
+
+  // Generating the copper paths accesses the board items which are not
+  // thread-safe (e.g. stroke texts), thus it is done in this thread.
+  QVector<CopperArea> areas;
+  foreach (const GraphicsLayer* layer, mBoard.getLayerStack().getAllLayers()) {
+    if ((!layer->isCopperLayer()) || (!layer->isEnabled())) {
+      continue;
+    }
+    foreach (const NetSignal* netsignal, netsignals) {
+      const ClipperLib::Paths rawPaths = getCopperPaths(*layer, {netsignal});
+      CopperArea area{layer, netsignal, rawPaths, {}, true, {}, {}};
+      const CacheKey key(layer, netsignal);
+      const QString name = netsignal ? *netsignal->getName() : QString();
+      if (cache) {
+        cache->areas.insert(key, CachedArea{name, rawPaths, {}});
+      }
+      auto it = cachedAreas.constFind(key);
+      if ((it != cachedAreas.constEnd()) && (it->name == name) &&
+          (it->paths == rawPaths)) {
+        area.paths = it->offsetPaths;
+        area.changed = false;
+        ++mCache->mReusedAreas;
+      }
+      areas.append(area);
+    }
+  }
+
+  // Offsetting only works on the Clipper paths, so it can run in parallel.
+  QtConcurrent::blockingMap(areas, [offset](CopperArea& area) {
+    if (area.changed && (offset != 0)) {
+      ClipperHelpers::offset(area.paths, offset, maxArcTolerance());
+    }
+    area.bounds = ClipperHelpers::getBounds(area.paths);
+  });
+  if (cache) {
+    foreach (const CopperArea& area, areas) {
+      cache->areas[CacheKey(area.layer, area.netSignal)].offsetPaths =
+          area.paths;
+    }
+  }
+  return areas;
+}
+
+template <typename T>
+void BoardDesignRuleCheck::findCandidates(QVector<T>& areas, int begin,
+                                          int end) noexcept {
+  QVector<ClipperLib::IntRect> bounds;
+  for (int i = begin; i < end; ++i) {
+    bounds.append(areas.at(i).bounds);
+  }
+  const QVector<QVector<int>> overlaps =
+      ClipperHelpers::findOverlappingBounds(bounds);
+  for (int i = 0; i < overlaps.count(); ++i) {
+    QVector<Candidate>& candidates = areas[begin + i].candidates;
+    foreach (int k, overlaps.at(i)) {
+      candidates.append(Candidate{begin + k, {}});
+    }
+  }
+}
+
 ClipperLib::Paths BoardDesignRuleCheck::getDeviceCourtyardPaths(
     const BI_Device& device, const GraphicsLayer* layer) {
   ClipperLib::Paths paths;
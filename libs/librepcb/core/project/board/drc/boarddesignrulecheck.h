@@ -133,6 +133,8 @@ public:
         checkMissingConnections(true) {}
   };
 
+  class Cache;
+
   // Constructors / Destructor
   explicit BoardDesignRuleCheck(Board& board, const Options& options,
                                 QObject* parent = nullptr) noexcept;
@@ -146,6 +148,23 @@ public:
     return mMessages;
   }
 
+  // Setters
+
+  /**
+   * @brief Set a cache to speed up repeated runs on the same board
+   *
+   * If set, copper and courtyard areas which did not change since the last
+   * run with the same cache object are not checked again, but their messages
+   * are taken from the cache. Afterwards the cache is updated with the
+   * results of this run.
+   *
+   * @param cache   The cache (initially empty) to use, or `nullptr` to
+   *                always check everything.
+   */
+  void setCache(const std::shared_ptr<Cache>& cache) noexcept {
+    mCache = cache;
+  }
+
   // General Methods
   void execute();
 
@@ -156,6 +175,53 @@ signals:
   void progressMessage(const QString& msg);
   void finished();
 
+private:  // Types
+  /// An area to be checked against another area
+  struct Candidate {
+    int index;  ///< Index of the other area
+    QList<BoardDesignRuleCheckMessage> messages;
+  };
+
+  /// The copper of a single net on a single layer
+  struct CopperArea {
+    const GraphicsLayer* layer;
+    const NetSignal* netSignal;  ///< `nullptr` for unconnected copper
+    ClipperLib::Paths paths;
+    ClipperLib::IntRect bounds;
+    bool changed;  ///< Whether the area has changed since the cached run
+    QVector<Candidate> candidates;  ///< Following areas with overlapping bounds
+    QList<BoardDesignRuleCheckMessage> messages;
+  };
+
+  /// The courtyard of a single device on a single layer
+  struct CourtyardArea {
+    const GraphicsLayer* layer;
+    const BI_Device* device;
+    ClipperLib::Paths paths;
+    ClipperLib::IntRect bounds;
+    bool changed;  ///< Whether the area has changed since the cached run
+    QVector<Candidate> candidates;  ///< Following areas with overlapping bounds
+  };
+
+  /// Layer + net signal or device, used as key of cached areas
+  typedef QPair<const void*, const void*> CacheKey;
+
+  /// Cached area of #CopperArea or #CourtyardArea
+  struct CachedArea {
+    QString name;
+    ClipperLib::Paths paths;  ///< Before offsetting
+    ClipperLib::Paths offsetPaths;
+  };
+
+  /// Cached results of a check, see #Cache
+  struct CachedCheck {
+    Length offset;
+    ClipperLib::Paths restrictedArea;
+    QHash<CacheKey, CachedArea> areas;
+    QHash<QPair<CacheKey, CacheKey>, QList<BoardDesignRuleCheckMessage>>
+        messages;
+  };
+
 private:  // Methods
   void rebuildPlanes(int progressStart, int progressEnd);
   void checkForMissingConnections(int progressStart, int progressEnd);
@@ -176,6 +242,10 @@ private:  // Methods
                               const Transform& transform2 = Transform());
   const ClipperLib::Paths& getCopperPaths(
       const GraphicsLayer& layer, const QSet<const NetSignal*>& netsignals);
+  QVector<CopperArea> getCopperAreas(const Length& offset,
+                                     CachedCheck* cache);
+  template <typename T>
+  static void findCandidates(QVector<T>& areas, int begin, int end) noexcept;
   ClipperLib::Paths getDeviceCourtyardPaths(const BI_Device& device,
                                             const GraphicsLayer* layer);
   QVector<Path> getHoleLocation(const Hole& hole,
@@ -200,6 +270,48 @@ private:  // Data
   QList<BoardDesignRuleCheckMessage> mMessages;
   QHash<QPair<const GraphicsLayer*, QSet<const NetSignal*>>, ClipperLib::Paths>
       mCachedPaths;
+  std::shared_ptr<Cache> mCache;
+};
+
+/*******************************************************************************
+ *  Class BoardDesignRuleCheck::Cache
+ ******************************************************************************/
+
+/**
+ * @brief Intermediate results of a ::librepcb::BoardDesignRuleCheck run
+ *
+ * Keeps the input geometry and messages of the copper and courtyard
+ * clearance checks. Changes are detected by comparing the geometry and names
+ * with the cached ones, so the cache stays valid no matter how the board was
+ * modified in the meantime.
+ *
+ * @see ::librepcb::BoardDesignRuleCheck::setCache()
+ */
+class BoardDesignRuleCheck::Cache final {
+public:
+  // Constructors / Destructor
+  Cache() noexcept {}
+  Cache(const Cache& other) = delete;
+  ~Cache() noexcept {}
+
+  // Getters
+
+  /**
+   * @brief Get the number of areas taken from the cache in the last run
+   *
+   * @return Count of unchanged copper and courtyard areas
+   */
+  int getReusedAreaCount() const noexcept { return mReusedAreas; }
+
+  // Operator Overloadings
+  Cache& operator=(const Cache& rhs) = delete;
+
+private:  // Data
+  friend class BoardDesignRuleCheck;
+  int mReusedAreas = 0;
+  CachedCheck mBoardClearances;
+  CachedCheck mCopperClearances;
+  CachedCheck mCourtyardClearances;
 };
 
 /*******************************************************************************
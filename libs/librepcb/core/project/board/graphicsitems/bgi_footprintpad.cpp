@@ -23,6 +23,7 @@
 #include "bgi_footprintpad.h"
 
 #include "../../../application.h"
+#include "../../../geometry/padgeometrycache.h"
 #include "../../../library/pkg/footprint.h"
 #include "../../../library/pkg/package.h"
 #include "../../circuit/netsignal.h"
@@ -104,7 +105,10 @@ void BGI_FootprintPad::updateCacheAndRepaint() noexcept {
       GraphicsLayer::sTopSolderPaste,
   };
 
-  // Determine content to draw on each layer.
+  // Determine content to draw on each layer. The painter paths are shared
+  // with all other pads of the same geometry, only the transform of this
+  // graphics item differs.
+  PadGeometryCache& cache = PadGeometryCache::instance();
   disconnectLayerEditedSlots();
   mCopperLayer = getLayer(mPad.getLayerName());
   mContents.clear();
@@ -115,7 +119,7 @@ void BGI_FootprintPad::updateCacheAndRepaint() noexcept {
         mContents.append(LayerContent{
             layer,
             layer->isCopperLayer() ? mCopperLayer : layer,
-            geometry.toQPainterPathPx(),
+            cache.getQPainterPathPx(geometry),
         });
       }
     }
@@ -128,7 +132,7 @@ void BGI_FootprintPad::updateCacheAndRepaint() noexcept {
   foreach (const LayerContent& content, mContents) {
     mBoundingRect |= content.path.boundingRect();
   }
-  mShape = mLibPad.getGeometry().toFilledQPainterPathPx();
+  mShape = cache.getFilledQPainterPathPx(mLibPad.getGeometry());
 
   update();
 }
@@ -140,13 +144,26 @@ void BGI_FootprintPad::updateCacheAndRepaint() noexcept {
 void BGI_FootprintPad::paint(QPainter* painter,
                              const QStyleOptionGraphicsItem* option,
                              QWidget* widget) {
-  Q_UNUSED(option);
   Q_UNUSED(widget);
+  const qreal lod =
+      option->levelOfDetailFromTransform(painter->worldTransform());
 
   const NetSignal* netsignal = mPad.getCompSigInstNetSignal();
   bool highlight =
       mPad.isSelected() || (netsignal && netsignal->isHighlighted());
 
+  // If the pad is only a few pixels large, drawing rects is much faster than
+  // drawing the exact paths and looks the same.
+  const bool simplified =
+      (qMax(mBoundingRect.width(), mBoundingRect.height()) * lod) < 3;
+  auto drawPath = [painter, simplified](const QPainterPath& path) {
+    if (simplified) {
+      painter->drawRect(path.boundingRect());
+    } else {
+      painter->drawPath(path);
+    }
+  };
+
   // Draw bottom non-copper layers.
   foreach (const LayerContent& content, mContents) {
     if ((content.drawLayer != mCopperLayer) &&
@@ -154,7 +171,7 @@ void BGI_FootprintPad::paint(QPainter* painter,
         (content.drawLayer->isVisible())) {
       painter->setPen(Qt::NoPen);
       painter->setBrush(content.drawLayer->getColor(highlight));
-      painter->drawPath(content.path);
+      drawPath(content.path);
     }
   }
 
@@ -167,7 +184,7 @@ void BGI_FootprintPad::paint(QPainter* painter,
         (!filledCopperPaths.contains(content.path))) {
       painter->setPen(Qt::NoPen);
       painter->setBrush(content.drawLayer->getColor(highlight));
-      painter->drawPath(content.path);
+      drawPath(content.path);
       filledCopperPaths.append(content.path);
     }
   }
@@ -182,13 +199,13 @@ void BGI_FootprintPad::paint(QPainter* painter,
         (!outlineCopperPaths.contains(content.path))) {
       painter->setPen(QPen(content.drawLayer->getColor(highlight), 0));
       painter->setBrush(Qt::NoBrush);
-      painter->drawPath(content.path);
+      drawPath(content.path);
       outlineCopperPaths.append(content.path);
     }
   }
 
-  // Draw text.
-  if (mCopperLayer && mCopperLayer->isVisible()) {
+  // Draw text (only if the 1px font is readable on screen).
+  if (mCopperLayer && mCopperLayer->isVisible() && (lod > 4)) {
     painter->setFont(mFont);
     painter->setPen(mCopperLayer->getColor(highlight).lighter(150));
     painter->drawText(mShape.boundingRect(), Qt::AlignCenter,
@@ -201,7 +218,7 @@ void BGI_FootprintPad::paint(QPainter* painter,
         (content.drawLayer->isTopLayer()) && (content.drawLayer->isVisible())) {
       painter->setPen(Qt::NoPen);
       painter->setBrush(content.drawLayer->getColor(highlight));
-      painter->drawPath(content.path);
+      drawPath(content.path);
     }
   }
 }
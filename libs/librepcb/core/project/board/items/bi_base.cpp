@@ -73,7 +73,7 @@ void BI_Base::setSelected(bool selected) noexcept {
 void BI_Base::addToBoard(QGraphicsItem* item) noexcept {
   Q_ASSERT(!mIsAddedToBoard);
   if (item) {
-    mBoard.getGraphicsScene().addItem(*item);
+    mBoard.getGraphicsScene().addItem(*item, this);
   }
   mIsAddedToBoard = true;
 }
@@ -354,15 +354,18 @@ void BI_NetSegment::selectAll() noexcept {
     netline->setSelected(netline->isSelectable());
 }
 
-void BI_NetSegment::setSelectionRect(const QRectF rectPx) noexcept {
+void BI_NetSegment::setSelectionRect(
+    const QRectF rectPx, const QSet<BI_Base*>& candidates) noexcept {
   foreach (BI_Via* via, mVias)
-    via->setSelected(via->isSelectable() &&
+    via->setSelected(candidates.contains(via) && via->isSelectable() &&
                      via->getGrabAreaScenePx().intersects(rectPx));
   foreach (BI_NetPoint* netpoint, mNetPoints)
-    netpoint->setSelected(netpoint->isSelectable() &&
+    netpoint->setSelected(candidates.contains(netpoint) &&
+                          netpoint->isSelectable() &&
                           netpoint->getGrabAreaScenePx().intersects(rectPx));
   foreach (BI_NetLine* netline, mNetLines)
-    netline->setSelected(netline->isSelectable() &&
+    netline->setSelected(candidates.contains(netline) &&
+                         netline->isSelectable() &&
                          netline->getGrabAreaScenePx().intersects(rectPx));
 }
 
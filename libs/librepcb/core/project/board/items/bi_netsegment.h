@@ -115,7 +115,8 @@ public:
   void addToBoard() override;
   void removeFromBoard() override;
   void selectAll() noexcept;
-  void setSelectionRect(const QRectF rectPx) noexcept;
+  void setSelectionRect(const QRectF rectPx,
+                        const QSet<BI_Base*>& candidates) noexcept;
   void clearSelection() const noexcept;
 
   /**
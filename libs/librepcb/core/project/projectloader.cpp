@@ -63,6 +63,7 @@
 #include "schematic/items/si_text.h"
 #include "schematic/schematic.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -89,6 +90,7 @@ std::unique_ptr<Project> ProjectLoader::open(
     const QString& filename) {
   Q_ASSERT(directory);
   mUpgradeMessages = tl::nullopt;
+  mPrefetchedFiles.clear();
 
   QElapsedTimer timer;
   timer.start();
@@ -136,6 +138,7 @@ std::unique_ptr<Project> ProjectLoader::open(
 
   // Load project.
   std::unique_ptr<Project> p(new Project(std::move(directory), filename));
+  prefetchFiles(*p);
   loadMetadata(*p);
   loadSettings(*p);
   loadLibrary(*p);
@@ -143,6 +146,7 @@ std::unique_ptr<Project> ProjectLoader::open(
   loadSchematics(*p);
   loadBoards(*p);
   restoreApprovedErcMessages(*p);
+  mPrefetchedFiles.clear();  // Release files which were not loaded.
 
   // Done!
   qDebug() << "Successfully opened project in" << timer.elapsed() << "ms.";
@@ -153,11 +157,108 @@ std::unique_ptr<Project> ProjectLoader::open(
  *  Private Methods
  ******************************************************************************/
 
+void ProjectLoader::prefetchFiles(Project& p) {
+  qDebug() << "Read and parse project files...";
+  QElapsedTimer timer;
+  timer.start();
+
+  // Determine the files to prefetch. The schematics and boards index files
+  // are needed to know the other files, so they are parsed right here.
+  TransactionalDirectory& dir = p.getDirectory();
+  QStringList files = {"project/metadata.lp", "project/settings.lp",
+                       "circuit/circuit.lp", "circuit/erc.lp"};
+  collectLibraryElementFiles<Symbol>(p, "sym", files);
+  collectLibraryElementFiles<Package>(p, "pkg", files);
+  collectLibraryElementFiles<Component>(p, "cmp", files);
+  collectLibraryElementFiles<Device>(p, "dev", files);
+  auto parseIndex = [&](const QString& fp,
+                        const QString& childName) -> QList<FilePath> {
+    QList<FilePath> paths;
+    try {
+      const SExpression root =
+          SExpression::parse(dir.read(fp), dir.getAbsPath(fp));
+      mPrefetchedFiles.insert(dir.getAbsPath(fp), root);
+      foreach (const SExpression* node, root.getChildren(childName)) {
+        paths.append(FilePath::fromRelative(p.getPath(),
+                                            node->getChild("@0").getValue()));
+      }
+    } catch (const Exception&) {
+      // Errors are reported when the index file gets loaded.
+    }
+    return paths;
+  };
+  foreach (const FilePath& fp,
+           parseIndex("schematics/schematics.lp", "schematic")) {
+    files.append(fp.toRelative(p.getPath()));
+  }
+  const QStringList boardUserFiles = {"planes.user.lp", "settings.user.lp"};
+  foreach (const FilePath& fp, parseIndex("boards/boards.lp", "board")) {
+    files.append(fp.toRelative(p.getPath()));
+    foreach (const QString& fileName, boardUserFiles) {
+      const QString userFp =
+          fp.getParentDir().getPathTo(fileName).toRelative(p.getPath());
+      if (dir.fileExists(userFp)) {
+        files.append(userFp);
+      }
+    }
+  }
+
+  // Read and parse all files in parallel. Nothing is written to the file
+  // system at this point, so reading from it is thread-safe. Errors are
+  // ignored here, the affected files are just parsed again later when they
+  // get loaded, so their errors are reported (or handled) as usual.
+  std::function<tl::optional<SExpression>(const QString&)> parse =
+      [&dir](const QString& fp) -> tl::optional<SExpression> {
+    try {
+      return SExpression::parse(dir.read(fp), dir.getAbsPath(fp));
+    } catch (const Exception&) {
+      return tl::nullopt;
+    }
+  };
+  const QVector<tl::optional<SExpression>> roots =
+      QtConcurrent::blockingMapped<QVector<tl::optional<SExpression>>>(files,
+                                                                       parse);
+  for (int i = 0; i < files.count(); ++i) {
+    if (roots.at(i)) {
+      mPrefetchedFiles.insert(dir.getAbsPath(files.at(i)), *roots.at(i));
+    }
+  }
+
+  qDebug() << "Prefetched" << mPrefetchedFiles.count() << "files in"
+           << timer.elapsed() << "ms.";
+}
+
+template <typename ElementType>
+void ProjectLoader::collectLibraryElementFiles(Project& p,
+                                               const QString& dirname,
+                                               QStringList& files) {
+  TransactionalDirectory& libDir = p.getLibrary().getDirectory();
+  foreach (const QString& sub, libDir.getDirs(dirname)) {
+    const TransactionalDirectory dir(libDir, dirname % "/" % sub);
+    // Elements which need to be upgraded are parsed after the upgrade, i.e.
+    // not prefetched.
+    if (LibraryBaseElement::isValidElementDirectory<ElementType>(dir, "") &&
+        isUpToDate<ElementType>(dir)) {
+      const QString fileName = ElementType::getLongElementName() % ".lp";
+      files.append(dir.getAbsPath(fileName).toRelative(p.getPath()));
+    }
+  }
+}
+
+SExpression ProjectLoader::parseFile(const TransactionalDirectory& dir,
+                                     const QString& path) {
+  const FilePath fp = dir.getAbsPath(path);
+  if (mPrefetchedFiles.contains(fp)) {
+    return mPrefetchedFiles.take(fp);
+  } else {
+    return SExpression::parse(dir.read(path), fp);
+  }
+}
+
 void ProjectLoader::loadMetadata(Project& p) {
   qDebug() << "Load project metadata...";
   const QString fp = "project/metadata.lp";
-  SExpression root = SExpression::parse(p.getDirectory().read(fp),
-                                        p.getDirectory().getAbsPath(fp));
+  SExpression root = parseFile(p.getDirectory(), fp);
 
   p.setUuid(deserialize<Uuid>(root.getChild("@0")));
   p.setName(deserialize<ElementName>(root.getChild("name/@0")));
@@ -172,8 +273,7 @@ void ProjectLoader::loadMetadata(Project& p) {
 void ProjectLoader::loadSettings(Project& p) {
   qDebug() << "Load project settings...";
   const QString fp = "project/settings.lp";
-  const SExpression root = SExpression::parse(p.getDirectory().read(fp),
-                                              p.getDirectory().getAbsPath(fp));
+  const SExpression root = parseFile(p.getDirectory(), fp);
   {
     QStringList l;
     foreach (const SExpression* node,
@@ -208,6 +308,17 @@ void ProjectLoader::loadLibrary(Project& p) {
   qDebug() << "Successfully loaded project library.";
 }
 
+template <typename ElementType>
+bool ProjectLoader::isUpToDate(const TransactionalDirectory& dir) {
+  try {
+    const Version fileFormat = LibraryBaseElement::readFileFormat(
+        dir, ".librepcb-" % ElementType::getShortElementName());
+    return FileFormatMigration::getMigrations(fileFormat).isEmpty();
+  } catch (const Exception&) {
+    return false;  // The error will be reported when opening the element.
+  }
+}
+
 template <typename ElementType>
 void ProjectLoader::loadLibraryElements(
     Project& p, const QString& dirname, const QString& type,
@@ -225,9 +336,16 @@ void ProjectLoader::loadLibraryElements(
       continue;
     }
 
-    // Load the library element.
-    ElementType* element =
-        ElementType::open(std::move(dir)).release();  // can throw
+    // Load the library element. If its file format is up to date, the file
+    // has already been parsed by prefetchFiles().
+    ElementType* element = nullptr;
+    if (isUpToDate<ElementType>(*dir)) {
+      const SExpression root =
+          parseFile(*dir, ElementType::getLongElementName() % ".lp");
+      element = ElementType::open(std::move(dir), root).release();  // can throw
+    } else {
+      element = ElementType::open(std::move(dir)).release();  // can throw
+    }
     (p.getLibrary().*addFunction)(*element);
     ++count;
   }
@@ -239,8 +357,7 @@ void ProjectLoader::loadLibraryElements(
 void ProjectLoader::loadCircuit(Project& p) {
   qDebug() << "Load circuit...";
   const QString fp = "circuit/circuit.lp";
-  SExpression root = SExpression::parse(p.getDirectory().read(fp),
-                                        p.getDirectory().getAbsPath(fp));
+  SExpression root = parseFile(p.getDirectory(), fp);
 
   // Load net classes.
   foreach (const SExpression* node, root.getChildren("netclass")) {
@@ -330,8 +447,7 @@ void ProjectLoader::loadCircuit(Project& p) {
 void ProjectLoader::loadSchematics(Project& p) {
   qDebug() << "Load schematics...";
   const QString fp = "schematics/schematics.lp";
-  const SExpression indexRoot = SExpression::parse(
-      p.getDirectory().read(fp), p.getDirectory().getAbsPath(fp));
+  const SExpression indexRoot = parseFile(p.getDirectory(), fp);
   foreach (const SExpression* indexNode, indexRoot.getChildren("schematic")) {
     loadSchematic(p, indexNode->getChild("@0").getValue());
   }
@@ -343,7 +459,7 @@ void ProjectLoader::loadSchematic(Project& p, const QString& relativeFilePath) {
   const FilePath fp = FilePath::fromRelative(p.getPath(), relativeFilePath);
   std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
       p.getDirectory(), fp.getParentDir().toRelative(p.getPath())));
-  const SExpression root = SExpression::parse(dir->read(fp.getFilename()), fp);
+  const SExpression root = parseFile(*dir, fp.getFilename());
 
   Schematic* schematic =
       new Schematic(p, std::move(dir), fp.getParentDir().getFilename(),
@@ -476,8 +592,7 @@ void ProjectLoader::loadSchematicNetSegment(Schematic& s,
 void ProjectLoader::loadBoards(Project& p) {
   qDebug() << "Load boards...";
   const QString fp = "boards/boards.lp";
-  const SExpression indexRoot = SExpression::parse(
-      p.getDirectory().read(fp), p.getDirectory().getAbsPath(fp));
+  const SExpression indexRoot = parseFile(p.getDirectory(), fp);
   foreach (const SExpression* node, indexRoot.getChildren("board")) {
     loadBoard(p, node->getChild("@0").getValue());
   }
@@ -488,7 +603,7 @@ void ProjectLoader::loadBoard(Project& p, const QString& relativeFilePath) {
   const FilePath fp = FilePath::fromRelative(p.getPath(), relativeFilePath);
   std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
       p.getDirectory(), fp.getParentDir().toRelative(p.getPath())));
-  const SExpression root = SExpression::parse(dir->read(fp.getFilename()), fp);
+  const SExpression root = parseFile(*dir, fp.getFilename());
 
   Board* board = new Board(p, std::move(dir), fp.getParentDir().getFilename(),
                            deserialize<Uuid>(root.getChild("@0")),
@@ -526,8 +641,10 @@ void ProjectLoader::loadBoard(Project& p, const QString& relativeFilePath) {
     board->addHole(*hole);
   }
 
-  // Rebuild all planes.
-  board->rebuildAllPlanes();
+  // Rebuild all planes, if they cannot be restored from the cache.
+  if (!loadBoardPlanesCache(*board)) {
+    board->rebuildAllPlanes();
+  }
 
   // Load user settings.
   loadBoardUserSettings(*board);
@@ -682,11 +799,44 @@ void ProjectLoader::loadBoardPlane(Board& b, const SExpression& node) {
   b.addPlane(*plane);
 }
 
+bool ProjectLoader::loadBoardPlanesCache(Board& b) noexcept {
+  try {
+    const QString fp = "planes.user.lp";
+    if (!b.getDirectory().fileExists(fp)) {
+      return false;
+    }
+    const SExpression root = parseFile(b.getDirectory(), fp);
+
+    // Only use the cache if nothing has changed since it was created.
+    const QByteArray hash = root.getChild("@0").getValue().toLatin1();
+    if (hash != b.calculatePlanesInputHash()) {
+      qInfo() << "Plane fragments cache is outdated, rebuilding planes.";
+      return false;
+    }
+
+    QHash<Uuid, QVector<Path>> fragments;
+    foreach (const SExpression* node, root.getChildren("plane")) {
+      QVector<Path>& planeFragments =
+          fragments[deserialize<Uuid>(node->getChild("@0"))];
+      foreach (const SExpression* child, node->getChildren("fragment")) {
+        planeFragments.append(Path(*child));
+      }
+    }
+    b.restoreAllPlanes(fragments, hash);
+    qDebug() << "Restored plane fragments from cache.";
+    return true;
+  } catch (const Exception& e) {
+    // The cache is not under version control and can be rebuilt at any
+    // time, so just ignore any errors.
+    qWarning() << "Could not load plane fragments cache:" << e.getMsg();
+    return false;
+  }
+}
+
 void ProjectLoader::loadBoardUserSettings(Board& b) {
   try {
     const QString fp = "settings.user.lp";
-    const SExpression root = SExpression::parse(
-        b.getDirectory().read(fp), b.getDirectory().getAbsPath(fp));
+    const SExpression root = parseFile(b.getDirectory(), fp);
 
     // Layers.
     for (const SExpression* node : root.getChildren("layer")) {
@@ -722,8 +872,7 @@ void ProjectLoader::loadBoardUserSettings(Board& b) {
 
 void ProjectLoader::restoreApprovedErcMessages(Project& p) {
   const QString fp = "circuit/erc.lp";
-  const SExpression root = SExpression::parse(p.getDirectory().read(fp),
-                                              p.getDirectory().getAbsPath(fp));
+  const SExpression root = parseFile(p.getDirectory(), fp);
 
   foreach (const SExpression* node, root.getChildren("approved")) {
     foreach (ErcMsg* ercMsg, p.getErcMsgList().getItems()) {
@@ -23,7 +23,9 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../fileio/filepath.h"
 #include "../serialization/fileformatmigration.h"
+#include "../serialization/sexpression.h"
 
 #include <optional/tl/optional.hpp>
 
@@ -39,7 +41,6 @@ namespace librepcb {
 class Board;
 class Project;
 class ProjectLibrary;
-class SExpression;
 class Schematic;
 class TransactionalDirectory;
 
@@ -72,10 +73,18 @@ public:
   ProjectLoader& operator=(const ProjectLoader& rhs) = delete;
 
 private:  // Methods
+  void prefetchFiles(Project& p);
+  template <typename ElementType>
+  void collectLibraryElementFiles(Project& p, const QString& dirname,
+                                  QStringList& files);
+  SExpression parseFile(const TransactionalDirectory& dir,
+                        const QString& path);
   void loadMetadata(Project& p);
   void loadSettings(Project& p);
   void loadLibrary(Project& p);
   template <typename ElementType>
+  static bool isUpToDate(const TransactionalDirectory& dir);
+  template <typename ElementType>
   void loadLibraryElements(Project& p, const QString& dirname,
                            const QString& type,
                            void (ProjectLibrary::*addFunction)(ElementType&));
@@ -89,11 +98,15 @@ private:  // Methods
   void loadBoardDeviceInstance(Board& b, const SExpression& node);
   void loadBoardNetSegment(Board& b, const SExpression& node);
   void loadBoardPlane(Board& b, const SExpression& node);
+  bool loadBoardPlanesCache(Board& b) noexcept;
   void loadBoardUserSettings(Board& b);
   void restoreApprovedErcMessages(Project& p);
 
 private:  // Data
   tl::optional<QList<FileFormatMigration::Message>> mUpgradeMessages;
+
+  /// Files already read and parsed by #prefetchFiles(), until they are loaded
+  QHash<FilePath, SExpression> mPrefetchedFiles;
 };
 
 /*******************************************************************************
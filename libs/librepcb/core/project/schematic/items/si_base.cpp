@@ -76,7 +76,7 @@ void SI_Base::setSelected(bool selected) noexcept {
 void SI_Base::addToSchematic(QGraphicsItem* item) noexcept {
   Q_ASSERT(!mIsAddedToSchematic);
   if (item) {
-    mSchematic.getGraphicsScene().addItem(*item);
+    mSchematic.getGraphicsScene().addItem(*item, this);
   }
   mIsAddedToSchematic = true;
 }
@@ -351,13 +351,17 @@ void SI_NetSegment::selectAll() noexcept {
     netlabel->setSelected(true);
 }
 
-void SI_NetSegment::setSelectionRect(const QRectF rectPx) noexcept {
+void SI_NetSegment::setSelectionRect(
+    const QRectF rectPx, const QSet<SI_Base*>& candidates) noexcept {
   foreach (SI_NetPoint* netpoint, mNetPoints)
-    netpoint->setSelected(netpoint->getGrabAreaScenePx().intersects(rectPx));
+    netpoint->setSelected(candidates.contains(netpoint) &&
+                          netpoint->getGrabAreaScenePx().intersects(rectPx));
   foreach (SI_NetLine* netline, mNetLines)
-    netline->setSelected(netline->getGrabAreaScenePx().intersects(rectPx));
+    netline->setSelected(candidates.contains(netline) &&
+                         netline->getGrabAreaScenePx().intersects(rectPx));
   foreach (SI_NetLabel* netlabel, mNetLabels)
-    netlabel->setSelected(netlabel->getGrabAreaScenePx().intersects(rectPx));
+    netlabel->setSelected(candidates.contains(netlabel) &&
+                          netlabel->getGrabAreaScenePx().intersects(rectPx));
 }
 
 void SI_NetSegment::clearSelection() const noexcept {
@@ -98,7 +98,8 @@ public:
   void addToSchematic() override;
   void removeFromSchematic() override;
   void selectAll() noexcept;
-  void setSelectionRect(const QRectF rectPx) noexcept;
+  void setSelectionRect(const QRectF rectPx,
+                        const QSet<SI_Base*>& candidates) noexcept;
   void clearSelection() const noexcept;
 
   /**
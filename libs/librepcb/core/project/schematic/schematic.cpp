@@ -100,6 +100,16 @@ bool Schematic::isEmpty() const noexcept {
           mTexts.isEmpty());
 }
 
+QSet<SI_Base*> Schematic::getItemsInRect(const QRectF& rectPx) const noexcept {
+  QSet<SI_Base*> items;
+  foreach (QObject* owner, mGraphicsScene->getItemOwnersInRect(rectPx)) {
+    if (SI_Base* item = qobject_cast<SI_Base*>(owner)) {
+      items.insert(item);
+    }
+  }
+  return items;
+}
+
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
@@ -336,23 +346,29 @@ void Schematic::setSelectionRect(const Point& p1, const Point& p2,
   mGraphicsScene->setSelectionRect(p1, p2);
   if (updateItems) {
     QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+    // only items found in the spatial index need to be tested exactly
+    const QSet<SI_Base*> candidates = getItemsInRect(rectPx);
     foreach (SI_Symbol* symbol, mSymbols) {
-      bool selectSymbol = symbol->getGrabAreaScenePx().intersects(rectPx);
+      bool selectSymbol = candidates.contains(symbol) &&
+          symbol->getGrabAreaScenePx().intersects(rectPx);
       symbol->setSelected(selectSymbol);
       foreach (SI_SymbolPin* pin, symbol->getPins()) {
-        bool selectPin = pin->getGrabAreaScenePx().intersects(rectPx);
+        bool selectPin = candidates.contains(pin) &&
+            pin->getGrabAreaScenePx().intersects(rectPx);
         pin->setSelected(selectSymbol || selectPin);
       }
     }
     foreach (SI_NetSegment* segment, mNetSegments) {
-      segment->setSelectionRect(rectPx);
+      segment->setSelectionRect(rectPx, candidates);
     }
     foreach (SI_Polygon* polygon, mPolygons) {
-      bool select = polygon->getGrabAreaScenePx().intersects(rectPx);
+      bool select = candidates.contains(polygon) &&
+          polygon->getGrabAreaScenePx().intersects(rectPx);
       polygon->setSelected(select);
     }
     foreach (SI_Text* text, mTexts) {
-      bool selectText = text->getGrabAreaScenePx().intersects(rectPx);
+      bool selectText = candidates.contains(text) &&
+          text->getGrabAreaScenePx().intersects(rectPx);
       text->setSelected(selectText);
     }
   }
@@ -121,6 +121,7 @@ public:
   TransactionalDirectory& getDirectory() noexcept { return *mDirectory; }
   GraphicsScene& getGraphicsScene() const noexcept { return *mGraphicsScene; }
   bool isEmpty() const noexcept;
+  QSet<SI_Base*> getItemsInRect(const QRectF& rectPx) const noexcept;
 
   // Getters: Attributes
   const Uuid& getUuid() const noexcept { return mUuid; }
@@ -35,18 +35,31 @@ namespace librepcb {
  *  Constructors / Destructor
  ******************************************************************************/
 
-SExpression::SExpression() noexcept : mType(Type::String) {
+SExpression::SExpression() noexcept
+  : mType(Type::String), mValueBegin(-1), mValueLength(0) {
 }
 
 SExpression::SExpression(Type type, const QString& value)
-  : mType(type), mValue(value) {
+  : mType(type), mValue(value), mValueBegin(-1), mValueLength(0) {
+}
+
+SExpression::SExpression(Type type,
+                         const std::shared_ptr<const Document>& document,
+                         int valueBegin, int valueLength) noexcept
+  : mType(type),
+    mValue(),
+    mValueBegin(valueBegin),
+    mValueLength(valueLength),
+    mDocument(document) {
 }
 
 SExpression::SExpression(const SExpression& other) noexcept
   : mType(other.mType),
     mValue(other.mValue),
+    mValueBegin(other.mValueBegin),
+    mValueLength(other.mValueLength),
     mChildren(other.mChildren),
-    mFilePath(other.mFilePath) {
+    mDocument(other.mDocument) {
 }
 
 SExpression::~SExpression() noexcept {
@@ -56,21 +69,26 @@ SExpression::~SExpression() noexcept {
  *  Getters
  ******************************************************************************/
 
+const FilePath& SExpression::getFilePath() const noexcept {
+  static const FilePath empty;
+  return mDocument ? mDocument->filePath : empty;
+}
+
 const QString& SExpression::getName() const {
   if (isList()) {
-    return mValue;
+    return value();
   } else {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
+    throw FileParseError(__FILE__, __LINE__, getFilePath(), -1, -1, QString(),
                          "Node is not a list.");
   }
 }
 
 const QString& SExpression::getValue() const {
   if (!isToken() && !isString()) {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, mValue,
+    throw FileParseError(__FILE__, __LINE__, getFilePath(), -1, -1, value(),
                          "Node is not a token or string.");
   }
-  return mValue;
+  return value();
 }
 
 QList<SExpression*> SExpression::getChildren(Type type) noexcept {
@@ -96,7 +114,7 @@ QList<const SExpression*> SExpression::getChildren(Type type) const noexcept {
 QList<SExpression*> SExpression::getChildren(const QString& name) noexcept {
   QList<SExpression*> children;
   for (SExpression& child : mChildren) {
-    if (child.isList() && (child.mValue == name)) {
+    if (child.isList() && child.hasName(QStringRef(&name))) {
       children.append(&child);
     }
   }
@@ -107,7 +125,7 @@ QList<const SExpression*> SExpression::getChildren(const QString& name) const
     noexcept {
   QList<const SExpression*> children;
   for (const SExpression& child : mChildren) {
-    if (child.isList() && (child.mValue == name)) {
+    if (child.isList() && child.hasName(QStringRef(&name))) {
       children.append(&child);
     }
   }
@@ -119,7 +137,7 @@ SExpression& SExpression::getChild(const QString& path) {
   if (child) {
     return *child;
   } else {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
+    throw FileParseError(__FILE__, __LINE__, getFilePath(), -1, -1, QString(),
                          QString("Child not found: %1").arg(path));
   }
 }
@@ -129,29 +147,17 @@ const SExpression& SExpression::getChild(const QString& path) const {
 }
 
 SExpression* SExpression::tryGetChild(const QString& path) noexcept {
+  // Walk along the path without splitting it into a list of strings since
+  // this method is called very often during deserialization.
   SExpression* child = this;
-  foreach (const QString& name, path.split('/')) {
-    if (name.startsWith('@')) {
-      bool valid = false;
-      int index = name.mid(1).toInt(&valid);
-      if ((valid) && (index >= 0) && skipLineBreaks(child->mChildren, index)) {
-        child = &child->mChildren[index];
-      } else {
-        return nullptr;
-      }
-    } else {
-      bool found = false;
-      for (SExpression& childchild : child->mChildren) {
-        if (childchild.isList() && (childchild.mValue == name)) {
-          child = &childchild;
-          found = true;
-          break;
-        }
-      }
-      if (!found) {
-        return nullptr;
-      }
+  int begin = 0;
+  while (child && (begin <= path.length())) {
+    int end = path.indexOf('/', begin);
+    if (end < 0) {
+      end = path.length();
     }
+    child = child->tryGetDirectChild(path.midRef(begin, end - begin));
+    begin = end + 1;
   }
   return child;
 }
@@ -168,6 +174,7 @@ const SExpression* SExpression::tryGetChild(const QString& path) const
 void SExpression::setName(const QString& name) {
   if (mType == Type::List) {
     mValue = name;
+    mValueBegin = -1;
   } else {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -207,11 +214,15 @@ void SExpression::removeChild(const SExpression& child) {
 }
 
 QByteArray SExpression::toByteArray() const {
-  QString str = toString(0);  // can throw
-  if (!str.endsWith('\n')) {
-    str += '\n';  // newline at end of file
+  // Write directly into a single UTF-8 buffer, pre-sized with an estimation
+  // of the output size to avoid reallocations.
+  QByteArray output;
+  output.reserve(estimateSize(0) + 1);
+  writeTo(output, 0);  // can throw
+  if (!output.endsWith('\n')) {
+    output.append('\n');  // newline at end of file
   }
-  return str.toUtf8();
+  return output;
 }
 
 /*******************************************************************************
@@ -220,15 +231,17 @@ QByteArray SExpression::toByteArray() const {
 
 bool SExpression::operator==(const SExpression& rhs) const noexcept {
   // Note: Ignore the filepath since it's not part of the actual node.
-  return (mType == rhs.mType) && (mValue == rhs.mValue) &&
+  return (mType == rhs.mType) && (value() == rhs.value()) &&
       (mChildren == rhs.mChildren);
 }
 
 SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
   mType = rhs.mType;
   mValue = rhs.mValue;
+  mValueBegin = rhs.mValueBegin;
+  mValueLength = rhs.mValueLength;
   mChildren = rhs.mChildren;
-  mFilePath = rhs.mFilePath;
+  mDocument = rhs.mDocument;
   return *this;
 }
 
@@ -236,25 +249,66 @@ SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
  *  Private Methods
  ******************************************************************************/
 
-QString SExpression::escapeString(const QString& string) noexcept {
-  static QHash<QChar, QString> replacements;
-  if (replacements.isEmpty()) {
-    replacements = {
-        {'"', "\\\""},  // Double quote *must* be escaped
-        {'\\', "\\\\"},  // Backslash *must* be escaped
-        {'\b', "\\b"},  // Escape backspace to increase readability
-        {'\f', "\\f"},  // Escape form feed to increase readability
-        {'\n', "\\n"},  // Escape line feed to increase readability
-        {'\r', "\\r"},  // Escape carriage return to increase readability
-        {'\t', "\\t"},  // Escape horizontal tab to increase readability
-        {'\v', "\\v"},  // Escape vertical tab to increase readability
-    };
+void SExpression::appendEscapedString(QByteArray& output,
+                                      const QString& string) noexcept {
+  // Note: Backslashes and double quotes never occur within multi-byte UTF-8
+  // characters, so the escaping can be done on the encoded bytes.
+  const QByteArray utf8 = string.toUtf8();
+  for (const char c : utf8) {
+    switch (c) {
+      case '"':  // Double quote *must* be escaped
+        output.append("\\\"");
+        break;
+      case '\\':  // Backslash *must* be escaped
+        output.append("\\\\");
+        break;
+      case '\b':  // Escape backspace to increase readability
+        output.append("\\b");
+        break;
+      case '\f':  // Escape form feed to increase readability
+        output.append("\\f");
+        break;
+      case '\n':  // Escape line feed to increase readability
+        output.append("\\n");
+        break;
+      case '\r':  // Escape carriage return to increase readability
+        output.append("\\r");
+        break;
+      case '\t':  // Escape horizontal tab to increase readability
+        output.append("\\t");
+        break;
+      case '\v':  // Escape vertical tab to increase readability
+        output.append("\\v");
+        break;
+      default:
+        output.append(c);
+        break;
+    }
   }
+}
 
-  QString escaped;
-  escaped.reserve(string.length() + (string.length() / 10));
-  foreach (const QChar& c, string) { escaped += replacements.value(c, c); }
-  return escaped;
+void SExpression::appendIndentation(QByteArray& output, int indent) noexcept {
+  static const QByteArray spaces(64, ' ');
+  while (indent > 0) {
+    const int count = qMin(indent, spaces.size());
+    output.append(spaces.constData(), count);
+    indent -= count;
+  }
+}
+
+void SExpression::appendToken(QByteArray& output) const {
+  if (mValueBegin >= 0) {
+    // Not materialized yet, thus it is a valid token from a parsed document.
+    output.append(mDocument->content.constData() + mValueBegin, mValueLength);
+  } else if (isValidToken(mValue)) {
+    output.append(mValue.toLatin1());  // valid tokens are ASCII only
+  } else if (mType == Type::List) {
+    throw LogicError(__FILE__, __LINE__,
+                     QString("Invalid S-Expression list name: %1").arg(mValue));
+  } else {
+    throw LogicError(__FILE__, __LINE__,
+                     QString("Invalid S-Expression token: %1").arg(mValue));
+  }
 }
 
 bool SExpression::isValidToken(const QString& token) noexcept {
@@ -275,20 +329,57 @@ bool SExpression::isValidTokenChar(const QChar& c) noexcept {
       ((c >= '0') && (c <= '9')) || allowedSpecialChars.contains(c);
 }
 
-QString SExpression::toString(int indent) const {
+bool SExpression::isValidTokenChar(char c) noexcept {
+  return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+      ((c >= '0') && (c <= '9')) || (c == '\\') || (c == '.') || (c == ':') ||
+      (c == '_') || (c == '-');
+}
+
+bool SExpression::isValidEscapedChar(char c) noexcept {
+  switch (c) {
+    case '\'':  // Single quote
+    case '"':  // Double quote
+    case '?':  // Question mark
+    case '\\':  // Backslash
+    case 'a':  // Audible bell
+    case 'b':  // Backspace
+    case 'f':  // Form feed
+    case 'n':  // Line feed
+    case 'r':  // Carriage return
+    case 't':  // Horizontal tab
+    case 'v':  // Vertical tab
+      return true;
+    default:
+      return false;
+  }
+}
+
+int SExpression::estimateSize(int indent) const noexcept {
+  // Non-ASCII characters and escaping are not taken into account.
+  int size = (mValueBegin >= 0) ? mValueLength : mValue.size();
   if (mType == Type::List) {
-    if (!isValidToken(mValue)) {
-      throw LogicError(
-          __FILE__, __LINE__,
-          QString("Invalid S-Expression list name: %1").arg(mValue));
+    size += 2;  // parentheses
+    foreach (const SExpression& child, mChildren) {
+      size += child.estimateSize(indent + 1) + 1;  // including space
     }
-    QString str = '(' + mValue;
+  } else if (mType == Type::String) {
+    size += 2;  // quotes
+  } else if (mType == Type::LineBreak) {
+    size += 1 + indent;
+  }
+  return size;
+}
+
+void SExpression::writeTo(QByteArray& output, int indent) const {
+  if (mType == Type::List) {
+    output.append('(');
+    appendToken(output);  // can throw
     bool lastCharIsSpace = false;
     const int lastIndex = mChildren.count() - 1;
     for (int i = 0; i < mChildren.count(); ++i) {
       const SExpression& child = mChildren.at(i);
       if ((!lastCharIsSpace) && (!child.isLineBreak())) {
-        str += ' ';
+        output.append(' ');
       }
       const bool nextChildIsLineBreak =
           (i < lastIndex) && mChildren.at(i + 1).isLineBreak();
@@ -298,19 +389,18 @@ QString SExpression::toString(int indent) const {
       if (lastCharIsSpace && (i == lastIndex)) {
         --currentIndent;
       }
-      str += child.toString(currentIndent);
+      child.writeTo(output, currentIndent);  // can throw
     }
-    return str + ')';
+    output.append(')');
   } else if (mType == Type::Token) {
-    if (!isValidToken(mValue)) {
-      throw LogicError(__FILE__, __LINE__,
-                       QString("Invalid S-Expression token: %1").arg(mValue));
-    }
-    return mValue;
+    appendToken(output);  // can throw
   } else if (mType == Type::String) {
-    return '"' + escapeString(mValue) + '"';
+    output.append('"');
+    appendEscapedString(output, value());
+    output.append('"');
   } else if (mType == Type::LineBreak) {
-    return '\n' + QString(' ').repeated(indent);
+    output.append('\n');
+    appendIndentation(output, indent);
   } else {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -338,16 +428,39 @@ SExpression SExpression::createLineBreak() {
 
 SExpression SExpression::parse(const QByteArray& content,
                                const FilePath& filePath) {
-  int index = 0;
-  QString contentStr = QString::fromUtf8(content);
-  skipWhitespaceAndComments(contentStr, index, true);  // Skip newlines as well.
-  if (index >= contentStr.length()) {
+  std::shared_ptr<Document> document = std::make_shared<Document>();
+  document->content = content;
+  document->filePath = filePath;
+  int index = content.startsWith("\xEF\xBB\xBF") ? 3 : 0;  // skip BOM
+  skipWhitespaceAndComments(content, index, true);  // Skip newlines as well.
+  if (index >= content.length()) {
     throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
                          "No S-Expression node found.");
   }
-  SExpression root = parse(contentStr, index, filePath);
-  skipWhitespaceAndComments(contentStr, index, true);  // Skip newlines as well.
-  if (index < contentStr.length()) {
+  SExpression root = parse(document, index);
+  skipWhitespaceAndComments(content, index, true);  // Skip newlines as well.
+  if (index < content.length()) {
+    throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
+                         "File contains more than one root node.");
+  }
+  return root;
+}
+
+SExpression SExpression::parse(const QByteArray& content,
+                               const FilePath& filePath,
+                               const QSet<QByteArray>& childNames) {
+  std::shared_ptr<Document> document = std::make_shared<Document>();
+  document->content = content;
+  document->filePath = filePath;
+  int index = content.startsWith("\xEF\xBB\xBF") ? 3 : 0;  // skip BOM
+  skipWhitespaceAndComments(content, index, true);  // Skip newlines as well.
+  if ((index >= content.length()) || (content.at(index) != '(')) {
+    throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
+                         "No S-Expression list node found.");
+  }
+  SExpression root = parseList(document, index, &childNames);
+  skipWhitespaceAndComments(content, index, true);  // Skip newlines as well.
+  if (index < content.length()) {
     throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
                          "File contains more than one root node.");
   }
@@ -358,6 +471,47 @@ SExpression SExpression::parse(const QByteArray& content,
  *  Private Methods
  ******************************************************************************/
 
+const QString& SExpression::value() const noexcept {
+  if (mValueBegin >= 0) {
+    const char* data = mDocument->content.constData() + mValueBegin;
+    if (mType == Type::String) {
+      mValue = unescapeString(data, mValueLength);
+    } else {
+      mValue = QString::fromLatin1(data, mValueLength);  // ASCII only
+    }
+    mValueBegin = -1;
+  }
+  return mValue;
+}
+
+bool SExpression::hasName(const QStringRef& name) const noexcept {
+  if (mValueBegin >= 0) {
+    // Compare without materializing the name since the lookup of children by
+    // name is the most frequent operation on parsed documents.
+    return QLatin1String(mDocument->content.constData() + mValueBegin,
+                         mValueLength) == name;
+  } else {
+    return mValue == name;
+  }
+}
+
+SExpression* SExpression::tryGetDirectChild(const QStringRef& name) noexcept {
+  if (name.startsWith('@')) {
+    bool valid = false;
+    int index = name.mid(1).toInt(&valid);
+    if ((valid) && (index >= 0) && skipLineBreaks(mChildren, index)) {
+      return &mChildren[index];
+    }
+  } else {
+    for (SExpression& child : mChildren) {
+      if (child.isList() && child.hasName(name)) {
+        return &child;
+      }
+    }
+  }
+  return nullptr;
+}
+
 bool SExpression::isMultiLine() const noexcept {
   if (isLineBreak()) {
     return true;
@@ -383,132 +537,171 @@ bool SExpression::skipLineBreaks(const QList<SExpression>& children,
   return false;
 }
 
-SExpression SExpression::parse(const QString& content, int& index,
-                               const FilePath& filePath) {
+SExpression SExpression::parse(const std::shared_ptr<const Document>& document,
+                               int& index) {
+  const QByteArray& content = document->content;
   Q_ASSERT(index < content.length());
 
   if (content.at(index) == '\n') {
     ++index;  // consume the '\n'
     skipWhitespaceAndComments(content, index);  // consume following spaces
-    return createLineBreak();
+    return SExpression(Type::LineBreak, document, -1, 0);
   } else if (content.at(index) == '(') {
-    return parseList(content, index, filePath);
+    return parseList(document, index);
   } else if (content.at(index) == '"') {
-    return createString(parseString(content, index, filePath));
+    return parseString(document, index);
   } else {
-    return createToken(parseToken(content, index, filePath));
+    return parseToken(document, index, Type::Token);
   }
 }
 
-SExpression SExpression::parseList(const QString& content, int& index,
-                                   const FilePath& filePath) {
+SExpression SExpression::parseList(
+    const std::shared_ptr<const Document>& document, int& index,
+    const QSet<QByteArray>* childNames) {
+  const QByteArray& content = document->content;
   Q_ASSERT((index < content.length()) && (content.at(index) == '('));
 
   ++index;  // consume the '('
 
-  SExpression list = createList(parseToken(content, index, filePath));
+  SExpression list = parseToken(document, index, Type::List);
 
   while (true) {
     if (index >= content.length()) {
-      throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
+      throw FileParseError(__FILE__, __LINE__, document->filePath, -1, -1,
+                           QString(),
                            "S-Expression node ended without closing ')'.");
     }
     if (content.at(index) == ')') {
       ++index;  // consume the ')'
       skipWhitespaceAndComments(content, index);  // consume following spaces
       break;
+    } else if (childNames && (content.at(index) == '(')) {
+      // Determine the name of the child without allocating memory.
+      int end = index + 1;
+      while ((end < content.length()) && isValidTokenChar(content.at(end))) {
+        ++end;
+      }
+      const QByteArray name =
+          QByteArray::fromRawData(content.constData() + index + 1,
+                                  end - index - 1);
+      if (childNames->contains(name)) {
+        list.mChildren.append(parseList(document, index));
+      } else {
+        skipList(document, index);
+      }
     } else {
-      list.appendChild(parse(content, index, filePath));
+      list.mChildren.append(parse(document, index));
     }
   }
 
   return list;
 }
 
-QString SExpression::parseToken(const QString& content, int& index,
-                                const FilePath& filePath) {
-  int oldIndex = index;
+SExpression SExpression::parseToken(
+    const std::shared_ptr<const Document>& document, int& index, Type type) {
+  const QByteArray& content = document->content;
+  const int oldIndex = index;
   while ((index < content.length()) && (isValidTokenChar(content.at(index)))) {
     ++index;
   }
-  QString token = content.mid(oldIndex, index - oldIndex);
-  if (token.isEmpty()) {
+  if (index == oldIndex) {
     throw FileParseError(
-        __FILE__, __LINE__, filePath, -1, -1, QString(),
+        __FILE__, __LINE__, document->filePath, -1, -1, QString(),
         QString("Invalid token character detected: '%1'")
-            .arg(index < content.length() ? content.at(index) : QChar()));
+            .arg(QString::fromUtf8(content.mid(index, 4)).left(1)));
   }
+  SExpression token(type, document, oldIndex, index - oldIndex);
   skipWhitespaceAndComments(content, index);  // consume following spaces
   return token;
 }
 
-QString SExpression::parseString(const QString& content, int& index,
-                                 const FilePath& filePath) {
+SExpression SExpression::parseString(
+    const std::shared_ptr<const Document>& document, int& index) {
+  const QByteArray& content = document->content;
   ++index;  // consume the '"'
 
-  // Note: Until LibrePCB 0.1.5 we used the sexpresso library for escaping
-  // strings. This library escaped more characters than we do now. To still
-  // support reading the file format 0.1, we have to keep support for the
-  // old escaping behavior.
-  static QHash<QChar, QChar> escapedChars = {
-      {'\'', '\''},  // Single quote
-      {'"', '"'},  // Double quote
-      {'?', '\?'},  // Question mark
-      {'\\', '\\'},  // Backslash
-      {'a', '\a'},  // Audible bell
-      {'b', '\b'},  // Backspace
-      {'f', '\f'},  // Form feed
-      {'n', '\n'},  // Line feed
-      {'r', '\r'},  // Carriage return
-      {'t', '\t'},  // Horizontal tab
-      {'v', '\v'},  // Vertical tab
-  };
-
-  QString string;
-  bool escaped = false;
+  // Only find the end of the string and validate escape sequences here, the
+  // string is unescaped when it gets materialized. Note that the bytes of
+  // quotes and backslashes never occur within multi-byte UTF-8 characters.
+  const int begin = index;
   while (true) {
     if (index >= content.length()) {
-      throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                           "String ended without quote.");
+      throw FileParseError(__FILE__, __LINE__, document->filePath, -1, -1,
+                           QString(), "String ended without quote.");
     }
-    const QChar& c = content.at(index);
-    if (escaped) {
-      if (escapedChars.contains(c)) {
-        string += escapedChars[c];
-        ++index;
-        escaped = false;
-      } else {
-        throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                             QString("Illegal escape sequence: '\\%1'").arg(c));
-      }
-    } else if (c == '"') {
-      ++index;  // consume the '"'
-      skipWhitespaceAndComments(content, index);  // consume following spaces
+    const char c = content.at(index);
+    if (c == '"') {
       break;
     } else if (c == '\\') {
-      escaped = true;
-      ++index;
+      if ((index + 1 < content.length()) &&
+          (!isValidEscapedChar(content.at(index + 1)))) {
+        throw FileParseError(
+            __FILE__, __LINE__, document->filePath, -1, -1, QString(),
+            QString("Illegal escape sequence: '\\%1'")
+                .arg(QString::fromUtf8(content.mid(index + 1, 4)).left(1)));
+      }
+      index += 2;
     } else {
-      string += c;
       ++index;
     }
   }
+  SExpression string(Type::String, document, begin, index - begin);
+  ++index;  // consume the '"'
+  skipWhitespaceAndComments(content, index);  // consume following spaces
   return string;
 }
 
-void SExpression::skipWhitespaceAndComments(const QString& content, int& index,
-                                            bool skipNewline) {
-  static QSet<QChar> spaces = {' ', '\f', '\r', '\t', '\v'};
+void SExpression::skipList(const std::shared_ptr<const Document>& document,
+                           int& index) {
+  const QByteArray& content = document->content;
+  Q_ASSERT((index < content.length()) && (content.at(index) == '('));
+
+  // Only find the matching closing parenthesis, taking strings and comments
+  // into account since they may contain parentheses.
+  int depth = 0;
+  bool isString = false;
+  bool isComment = false;
+  while (index < content.length()) {
+    const char c = content.at(index);
+    ++index;
+    if (isComment) {
+      isComment = (c != '\n');
+    } else if (isString) {
+      if (c == '\\') {
+        ++index;  // skip the escaped character
+      } else if (c == '"') {
+        isString = false;
+      }
+    } else if (c == '"') {
+      isString = true;
+    } else if (c == ';') {
+      isComment = true;
+    } else if (c == '(') {
+      ++depth;
+    } else if ((c == ')') && (--depth == 0)) {
+      skipWhitespaceAndComments(content, index);  // consume following spaces
+      return;
+    }
+  }
+  throw FileParseError(__FILE__, __LINE__, document->filePath, -1, -1,
+                       QString(),
+                       "S-Expression node ended without closing ')'.");
+}
 
+void SExpression::skipWhitespaceAndComments(const QByteArray& content,
+                                            int& index,
+                                            bool skipNewline) noexcept {
   bool isComment = false;
   while (index < content.length()) {
-    const QChar& c = content.at(index);
+    const char c = content.at(index);
     if (c == ';') {  // Line-comment of the Lisp language
       isComment = true;
     } else if (c == '\n') {
       isComment = false;
     }
-    if (isComment || ((skipNewline) && (c == '\n')) || spaces.contains(c)) {
+    const bool isSpace = (c == ' ') || (c == '\f') || (c == '\r') ||
+        (c == '\t') || (c == '\v');
+    if (isComment || ((skipNewline) && (c == '\n')) || isSpace) {
       ++index;
     } else {
       break;
@@ -516,6 +709,48 @@ void SExpression::skipWhitespaceAndComments(const QString& content, int& index,
   }
 }
 
+QString SExpression::unescapeString(const char* data, int length) noexcept {
+  // Note: Until LibrePCB 0.1.5 we used the sexpresso library for escaping
+  // strings. This library escaped more characters than we do now. To still
+  // support reading the file format 0.1, we have to keep support for the
+  // old escaping behavior.
+  QByteArray string;
+  string.reserve(length);
+  for (int i = 0; i < length; ++i) {
+    char c = data[i];
+    if ((c == '\\') && (i + 1 < length)) {
+      c = data[++i];
+      switch (c) {
+        case 'a':
+          c = '\a';  // Audible bell
+          break;
+        case 'b':
+          c = '\b';  // Backspace
+          break;
+        case 'f':
+          c = '\f';  // Form feed
+          break;
+        case 'n':
+          c = '\n';  // Line feed
+          break;
+        case 'r':
+          c = '\r';  // Carriage return
+          break;
+        case 't':
+          c = '\t';  // Horizontal tab
+          break;
+        case 'v':
+          c = '\v';  // Vertical tab
+          break;
+        default:  // Single quote, double quote, question mark, backslash
+          break;
+      }
+    }
+    string.append(c);
+  }
+  return QString::fromUtf8(string);
+}
+
 /*******************************************************************************
  *  serialize() Specializations for C++/Qt Types
  ******************************************************************************/
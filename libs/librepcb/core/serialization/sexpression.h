@@ -28,6 +28,8 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -63,6 +65,12 @@ T deserialize(const SExpression& node);
 
 /**
  * @brief The SExpression class
+ *
+ * Parsed nodes do not hold a copy of their name or value, but only a
+ * reference into the UTF-8 encoded file content which is shared by all nodes
+ * of a document. Strings are materialized on the first call to #getName() or
+ * #getValue(). Thus even const objects must not be accessed from multiple
+ * threads at the same time.
  */
 class SExpression final {
   Q_DECLARE_TR_FUNCTIONS(SExpression)
@@ -82,7 +90,7 @@ public:
   ~SExpression() noexcept;
 
   // Getters
-  const FilePath& getFilePath() const noexcept { return mFilePath; }
+  const FilePath& getFilePath() const noexcept;
   Type getType() const noexcept { return mType; }
   bool isList() const noexcept { return mType == Type::List; }
   bool isToken() const noexcept { return mType == Type::Token; }
@@ -190,32 +198,77 @@ public:
   static SExpression createLineBreak();
   static SExpression parse(const QByteArray& content, const FilePath& filePath);
 
+  /**
+   * @brief Parse only some direct children of the root node
+   *
+   * All list children of the root node whose name is not contained in
+   * `childNames` are skipped without creating nodes for them (and without
+   * validating their content). This is much faster than #parse() if only a
+   * few small nodes of a large file are needed.
+   *
+   * @param content     File content to parse.
+   * @param filePath    Path of the file (for error messages).
+   * @param childNames  Names of the root node children to parse.
+   * @return The root node with the requested children.
+   * @throws ::librepcb::Exception if the content could not be parsed.
+   */
+  static SExpression parse(const QByteArray& content, const FilePath& filePath,
+                           const QSet<QByteArray>& childNames);
+
+private:  // Types
+  /**
+   * @brief A parsed file, shared by all nodes parsed from it
+   */
+  struct Document {
+    QByteArray content;  ///< UTF-8 encoded file content
+    FilePath filePath;
+  };
+
 private:  // Methods
   SExpression(Type type, const QString& value);
+  SExpression(Type type, const std::shared_ptr<const Document>& document,
+              int valueBegin, int valueLength) noexcept;
 
+  const QString& value() const noexcept;
+  bool hasName(const QStringRef& name) const noexcept;
+  SExpression* tryGetDirectChild(const QStringRef& name) noexcept;
   bool isMultiLine() const noexcept;
   static bool skipLineBreaks(const QList<SExpression>& children,
                              int& index) noexcept;
-  static SExpression parse(const QString& content, int& index,
-                           const FilePath& filePath);
-  static SExpression parseList(const QString& content, int& index,
-                               const FilePath& filePath);
-  static QString parseToken(const QString& content, int& index,
-                            const FilePath& filePath);
-  static QString parseString(const QString& content, int& index,
-                             const FilePath& filePath);
-  static void skipWhitespaceAndComments(const QString& content, int& index,
-                                        bool skipNewline = false);
-  static QString escapeString(const QString& string) noexcept;
+  static SExpression parse(const std::shared_ptr<const Document>& document,
+                           int& index);
+  static SExpression parseList(const std::shared_ptr<const Document>& document,
+                               int& index,
+                               const QSet<QByteArray>* childNames = nullptr);
+  static SExpression parseToken(
+      const std::shared_ptr<const Document>& document, int& index, Type type);
+  static SExpression parseString(
+      const std::shared_ptr<const Document>& document, int& index);
+  static void skipList(const std::shared_ptr<const Document>& document,
+                       int& index);
+  static void skipWhitespaceAndComments(const QByteArray& content, int& index,
+                                        bool skipNewline = false) noexcept;
+  static void appendEscapedString(QByteArray& output,
+                                  const QString& string) noexcept;
+  static QString unescapeString(const char* data, int length) noexcept;
   static bool isValidToken(const QString& token) noexcept;
   static bool isValidTokenChar(const QChar& c) noexcept;
-  QString toString(int indent) const;
+  static bool isValidTokenChar(char c) noexcept;
+  static bool isValidEscapedChar(char c) noexcept;
+  void appendToken(QByteArray& output) const;
+  static void appendIndentation(QByteArray& output, int indent) noexcept;
+  int estimateSize(int indent) const noexcept;
+  void writeTo(QByteArray& output, int indent) const;
 
 private:  // Data
   Type mType;
-  QString mValue;  ///< either a list name, a token or a string
+  mutable QString mValue;  ///< either a list name, a token or a string
+
+  /// Offset of the not yet materialized value in #mDocument, or -1
+  mutable int mValueBegin;
+  int mValueLength;  ///< Length of the not yet materialized value
   QList<SExpression> mChildren;
-  FilePath mFilePath;
+  std::shared_ptr<const Document> mDocument;  ///< Parsed document (optional)
 };
 
 /*******************************************************************************
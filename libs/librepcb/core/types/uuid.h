@@ -46,6 +46,11 @@ namespace librepcb {
  *
  * A valid UUID looks like this: "d79d354b-62bd-4866-996a-78941c575e78"
  *
+ * Internally the UUID is stored as two 64-bit integers, thus copying,
+ * comparing and hashing is cheap. It is converted to a string only by
+ * #toStr(). Comparing UUIDs gives the same result as comparing their
+ * strings.
+ *
  * @note This class guarantees that only Uuid objects representing a valid UUID
  * can be created (in opposite to QUuid which allows "Null UUIDs")! If you need
  * a nullable UUID, use tl::optional<librepcb::Uuid> instead.
@@ -69,7 +74,8 @@ public:
    *
    * @param other     Another ::librepcb::Uuid object
    */
-  Uuid(const Uuid& other) noexcept : mUuid(other.mUuid) {}
+  Uuid(const Uuid& other) noexcept
+    : mHigh(other.mHigh), mLow(other.mLow) {}
 
   /**
    * @brief Destructor
@@ -83,7 +89,7 @@ public:
    *
    * @return The UUID as a string
    */
-  QString toStr() const noexcept { return mUuid; }
+  QString toStr() const noexcept;
 
   //@{
   /**
@@ -91,18 +97,23 @@ public:
    *
    * @param rhs   The other object to compare
    *
-   * @return Result of comparing the UUIDs as strings
+   * @return Result of comparing the UUIDs (same as comparing the strings)
    */
   Uuid& operator=(const Uuid& rhs) noexcept {
-    mUuid = rhs.mUuid;
+    mHigh = rhs.mHigh;
+    mLow = rhs.mLow;
     return *this;
   }
-  bool operator==(const Uuid& rhs) const noexcept { return mUuid == rhs.mUuid; }
-  bool operator!=(const Uuid& rhs) const noexcept { return mUuid != rhs.mUuid; }
-  bool operator<(const Uuid& rhs) const noexcept { return mUuid < rhs.mUuid; }
-  bool operator>(const Uuid& rhs) const noexcept { return mUuid > rhs.mUuid; }
-  bool operator<=(const Uuid& rhs) const noexcept { return mUuid <= rhs.mUuid; }
-  bool operator>=(const Uuid& rhs) const noexcept { return mUuid >= rhs.mUuid; }
+  bool operator==(const Uuid& rhs) const noexcept {
+    return (mHigh == rhs.mHigh) && (mLow == rhs.mLow);
+  }
+  bool operator!=(const Uuid& rhs) const noexcept { return !(*this == rhs); }
+  bool operator<(const Uuid& rhs) const noexcept {
+    return (mHigh < rhs.mHigh) || ((mHigh == rhs.mHigh) && (mLow < rhs.mLow));
+  }
+  bool operator>(const Uuid& rhs) const noexcept { return rhs < *this; }
+  bool operator<=(const Uuid& rhs) const noexcept { return !(rhs < *this); }
+  bool operator>=(const Uuid& rhs) const noexcept { return !(*this < rhs); }
   //@}
 
   // Static Methods
@@ -148,14 +159,22 @@ public:
 
 private:  // Methods
   /**
-   * @brief Constructor which creates a Uuid object from a string
+   * @brief Constructor which creates a Uuid object from its binary value
    *
-   * @param str       The uuid as a string (lowercase and without braces)
+   * @param high      The first 64 bits of the UUID
+   * @param low       The last 64 bits of the UUID
    */
-  explicit Uuid(const QString& str) noexcept : mUuid(str) {}
+  Uuid(quint64 high, quint64 low) noexcept : mHigh(high), mLow(low) {}
+
+  static bool parse(const QString& str, quint64& high, quint64& low) noexcept;
+  static bool isValidType(quint64 high, quint64 low) noexcept;
 
 private:  // Data
-  QString mUuid;  ///< Guaranteed to always contain a valid UUID
+  // Guaranteed to always contain a valid UUID
+  quint64 mHigh;  ///< First 64 bits (first 16 hex digits)
+  quint64 mLow;  ///< Last 64 bits (last 16 hex digits)
+
+  friend uint qHash(const Uuid& key, uint seed) noexcept;
 };
 
 /*******************************************************************************
@@ -173,14 +192,14 @@ inline QDebug operator<<(QDebug stream, const Uuid& uuid) noexcept {
 }
 
 inline uint qHash(const Uuid& key, uint seed) noexcept {
-  return ::qHash(key.toStr(), seed);
+  return ::qHash(qMakePair(key.mHigh, key.mLow), seed);
 }
 
 }  // namespace librepcb
 
 namespace tl {
 inline uint qHash(const optional<librepcb::Uuid>& key, uint seed) noexcept {
-  return ::qHash(key ? key->toStr() : QString(), seed);
+  return key ? librepcb::qHash(*key, seed) : ::qHash(QString(), seed);
 }
 }  // namespace tl
 
@@ -24,6 +24,9 @@
 
 #include <QtCore>
 
+#include <algorithm>
+#include <limits>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -234,6 +237,71 @@ ClipperLib::Paths ClipperHelpers::flattenTree(
   return paths;
 }
 
+/*******************************************************************************
+ *  Bounding Boxes
+ ******************************************************************************/
+
+ClipperLib::IntRect ClipperHelpers::getBounds(
+    const ClipperLib::Paths& paths) noexcept {
+  ClipperLib::IntRect rect;
+  rect.left = std::numeric_limits<ClipperLib::cInt>::max();
+  rect.top = std::numeric_limits<ClipperLib::cInt>::max();
+  rect.right = std::numeric_limits<ClipperLib::cInt>::min();
+  rect.bottom = std::numeric_limits<ClipperLib::cInt>::min();
+  for (const ClipperLib::Path& path : paths) {
+    for (const ClipperLib::IntPoint& p : path) {
+      rect.left = std::min(rect.left, p.X);
+      rect.top = std::min(rect.top, p.Y);
+      rect.right = std::max(rect.right, p.X);
+      rect.bottom = std::max(rect.bottom, p.Y);
+    }
+  }
+  return rect;
+}
+
+bool ClipperHelpers::overlaps(const ClipperLib::IntRect& a,
+                              const ClipperLib::IntRect& b) noexcept {
+  return (a.left <= b.right) && (b.left <= a.right) && (a.top <= b.bottom) &&
+      (b.top <= a.bottom);
+}
+
+QVector<QVector<int>> ClipperHelpers::findOverlappingBounds(
+    const QVector<ClipperLib::IntRect>& bounds) noexcept {
+  // Sort all valid rects by their left edge.
+  QVector<int> sorted;
+  sorted.reserve(bounds.count());
+  for (int i = 0; i < bounds.count(); ++i) {
+    if (bounds.at(i).left <= bounds.at(i).right) {
+      sorted.append(i);
+    }
+  }
+  std::sort(sorted.begin(), sorted.end(), [&bounds](int a, int b) {
+    return bounds.at(a).left < bounds.at(b).left;
+  });
+
+  // Sweep from left to right, only rects starting before the current rect
+  // ends can overlap with it.
+  QVector<QVector<int>> result(bounds.count());
+  for (int i = 0; i < sorted.count(); ++i) {
+    const ClipperLib::IntRect& a = bounds.at(sorted.at(i));
+    for (int k = i + 1; k < sorted.count(); ++k) {
+      const ClipperLib::IntRect& b = bounds.at(sorted.at(k));
+      if (b.left > a.right) {
+        break;
+      }
+      if ((a.top <= b.bottom) && (b.top <= a.bottom)) {
+        const int first = std::min(sorted.at(i), sorted.at(k));
+        const int second = std::max(sorted.at(i), sorted.at(k));
+        result[first].append(second);
+      }
+    }
+  }
+  for (QVector<int>& candidates : result) {
+    std::sort(candidates.begin(), candidates.end());
+  }
+  return result;
+}
+
 /*******************************************************************************
  *  Conversion Methods
  ******************************************************************************/
@@ -74,6 +74,38 @@ public:
   static ClipperLib::Paths treeToPaths(const ClipperLib::PolyTree& tree);
   static ClipperLib::Paths flattenTree(const ClipperLib::PolyNode& node);
 
+  // Bounding Boxes
+
+  /**
+   * @brief Get the bounding box of paths
+   *
+   * @param paths   The paths to get the bounding box of.
+   *
+   * @return The bounding box. For empty paths, an invalid rect (left > right)
+   *         is returned which never overlaps with any other rect.
+   */
+  static ClipperLib::IntRect getBounds(const ClipperLib::Paths& paths) noexcept;
+
+  /**
+   * @brief Check if two bounding boxes overlap (including touching edges)
+   */
+  static bool overlaps(const ClipperLib::IntRect& a,
+                       const ClipperLib::IntRect& b) noexcept;
+
+  /**
+   * @brief Find all pairs of overlapping bounding boxes (sweep and prune)
+   *
+   * Useful as a broad phase before running expensive polygon operations on
+   * each pair of a list of paths.
+   *
+   * @param bounds  Bounding boxes as returned by #getBounds().
+   *
+   * @return For each index `i` of `bounds`, the ascending list of indices
+   *         `k > i` whose bounding boxes overlap with `bounds[i]`.
+   */
+  static QVector<QVector<int>> findOverlappingBounds(
+      const QVector<ClipperLib::IntRect>& bounds) noexcept;
+
   // Type Conversions
   static QVector<Path> convert(const ClipperLib::Paths& paths) noexcept;
   static Path convert(const ClipperLib::Path& path) noexcept;
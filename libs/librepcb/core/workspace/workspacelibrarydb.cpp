@@ -52,7 +52,8 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(const FilePath& librariesPath)
   : QObject(nullptr),
     mLibrariesPath(librariesPath),
     mFilePath(mLibrariesPath.getPathTo(
-        QString("cache_v%1.sqlite").arg(sCurrentDbVersion))) {
+        QString("cache_v%1.sqlite").arg(sCurrentDbVersion))),
+    mHasSearchIndex(false) {
   qDebug("Load workspace library database...");
 
   // open SQLite database
@@ -72,6 +73,7 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(const FilePath& librariesPath)
     writer.createAllTables();  // can throw
     writer.addInternalData("version", sCurrentDbVersion);  // can throw
   }
+  mHasSearchIndex = hasSearchIndex();
 
   // create library scanner object
   mLibraryScanner.reset(new WorkspaceLibraryScanner(mLibrariesPath, mFilePath));
@@ -231,19 +233,52 @@ FilePath WorkspaceLibraryDb::getLatestVersionFilePath(
 }
 
 QList<Uuid> WorkspaceLibraryDb::find(const QString& elementsTable,
-                                     const QString& keyword) const {
-  QSqlQuery query = mDb->prepareQuery(
-      "SELECT %elements.uuid FROM %elements "
-      "LEFT JOIN %elements_tr "
-      "ON %elements.id = %elements_tr.element_id "
-      "WHERE %elements_tr.name LIKE :keyword "
-      "OR %elements_tr.keywords LIKE :keyword "
-      "GROUP BY %elements.uuid "
-      "ORDER BY %elements_tr.name ASC",
-      {
-          {"%elements", elementsTable},
-      });
-  query.bindValue(":keyword", "%" + keyword + "%");
+                                     const QString& keyword, int limit) const {
+  QSqlQuery query;
+  if (mHasSearchIndex) {
+    // Build a full-text query which matches all words of the keyword as
+    // prefixes in names or keywords. Descriptions are not taken into account
+    // to avoid way too verbose results.
+    QStringList terms;
+    foreach (const QString& word,
+             keyword.split(QRegularExpression("[^\\p{L}\\p{N}]+"),
+                           QString::SkipEmptyParts)) {
+      terms.append("{name keywords} : \"" % word % "\"*");
+    }
+    if (terms.isEmpty()) {
+      return QList<Uuid>();
+    }
+    query = mDb->prepareQuery(
+        "SELECT %elements.uuid FROM %elements_fts "
+        "INNER JOIN %elements_tr "
+        "ON %elements_tr.id = %elements_fts.rowid "
+        "INNER JOIN %elements "
+        "ON %elements.id = %elements_tr.element_id "
+        "WHERE %elements_fts MATCH :match "
+        "GROUP BY %elements.uuid "
+        "ORDER BY MIN(bm25(%elements_fts, 10.0, 1.0, 5.0)) ASC, "
+        "MIN(%elements_tr.name) ASC "
+        "LIMIT :limit",
+        {
+            {"%elements", elementsTable},
+        });
+    query.bindValue(":match", terms.join(" "));
+  } else {
+    query = mDb->prepareQuery(
+        "SELECT %elements.uuid FROM %elements "
+        "LEFT JOIN %elements_tr "
+        "ON %elements.id = %elements_tr.element_id "
+        "WHERE %elements_tr.name LIKE :keyword "
+        "OR %elements_tr.keywords LIKE :keyword "
+        "GROUP BY %elements.uuid "
+        "ORDER BY %elements_tr.name ASC "
+        "LIMIT :limit",
+        {
+            {"%elements", elementsTable},
+        });
+    query.bindValue(":keyword", "%" + keyword + "%");
+  }
+  query.bindValue(":limit", limit);
   mDb->exec(query);
 
   QList<Uuid> uuids;
@@ -438,6 +473,18 @@ int WorkspaceLibraryDb::getDbVersion() const noexcept {
   }
 }
 
+bool WorkspaceLibraryDb::hasSearchIndex() const noexcept {
+  try {
+    QSqlQuery query = mDb->prepareQuery(
+        "SELECT COUNT(*) FROM sqlite_master "
+        "WHERE type = 'table' AND name = :name");
+    query.bindValue(":name", getTable<Device>() % "_fts");
+    return mDb->count(query) > 0;
+  } catch (const Exception& e) {
+    return false;
+  }
+}
+
 template <typename ElementType>
 QString WorkspaceLibraryDb::getTable() noexcept {
   return WorkspaceLibraryDbWriter::getElementTable<ElementType>();
@@ -131,15 +131,21 @@ public:
   /**
    * @brief Find elements by keyword
    *
+   * Names and keywords are searched for words starting with each word of
+   * the passed keyword, e.g. "res sm" finds "SMD Resistor".
+   *
    * @param keyword   Keyword to search for. Note that the translations for
    *                  all languages will be taken into account.
+   * @param limit     Maximum number of elements to return, or -1 for
+   *                  unlimited.
    *
-   * @return  UUIDs of elements matching the filter, sorted alphabetically
-   *          and without duplicates. Empty if no elements were found.
+   * @return  UUIDs of elements matching the filter, sorted by relevance (or
+   *          alphabetically if equally relevant) and without duplicates.
+   *          Empty if no elements were found.
    */
   template <typename ElementType>
-  QList<Uuid> find(const QString& keyword) const {
-    return find(getTable<ElementType>(), keyword);
+  QList<Uuid> find(const QString& keyword, int limit = -1) const {
+    return find(getTable<ElementType>(), keyword, limit);
   }
 
   /**
@@ -326,7 +332,8 @@ private:
                                       const FilePath& lib) const;
   FilePath getLatestVersionFilePath(
       const QMultiMap<Version, FilePath>& list) const noexcept;
-  QList<Uuid> find(const QString& elementsTable, const QString& keyword) const;
+  QList<Uuid> find(const QString& elementsTable, const QString& keyword,
+                   int limit) const;
   bool getTranslations(const QString& elementsTable, const FilePath& elemDir,
                        const QStringList& localeOrder, QString* name,
                        QString* description, QString* keywords) const;
@@ -342,6 +349,7 @@ private:
                            const tl::optional<Uuid>& category, int limit) const;
   static QSet<Uuid> getUuidSet(QSqlQuery& query);
   int getDbVersion() const noexcept;
+  bool hasSearchIndex() const noexcept;
   template <typename ElementType>
   static QString getTable() noexcept;
   template <typename ElementType>
@@ -352,9 +360,10 @@ private:
   const FilePath mFilePath;  ///< Path to the SQLite database file.
   QScopedPointer<SQLiteDatabase> mDb;  ///< The SQLite database.
   QScopedPointer<WorkspaceLibraryScanner> mLibraryScanner;
+  bool mHasSearchIndex;  ///< Whether the FTS5 search index is available
 
   // Constants
-  static const int sCurrentDbVersion = 3;
+  static const int sCurrentDbVersion = 5;
 };
 
 /*******************************************************************************
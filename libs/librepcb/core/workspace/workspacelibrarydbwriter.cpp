@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "workspacelibrarydbwriter.h"
 
+#include "../exceptions.h"
 #include "../library/cat/componentcategory.h"
 #include "../library/cat/packagecategory.h"
 #include "../library/cmp/component.h"
@@ -102,7 +103,9 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL, "
-      "`parent_uuid` TEXT"
+      "`parent_uuid` TEXT, "
+      "`files_modified` INTEGER NOT NULL DEFAULT 0, "
+      "`files_size` INTEGER NOT NULL DEFAULT 0"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS component_categories_tr ("
@@ -125,7 +128,9 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL, "
-      "`parent_uuid` TEXT"
+      "`parent_uuid` TEXT, "
+      "`files_modified` INTEGER NOT NULL DEFAULT 0, "
+      "`files_size` INTEGER NOT NULL DEFAULT 0"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS package_categories_tr ("
@@ -147,7 +152,9 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
-      "`deprecated` BOOLEAN NOT NULL"
+      "`deprecated` BOOLEAN NOT NULL, "
+      "`files_modified` INTEGER NOT NULL DEFAULT 0, "
+      "`files_size` INTEGER NOT NULL DEFAULT 0"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS symbols_tr ("
@@ -177,7 +184,9 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
-      "`deprecated` BOOLEAN NOT NULL"
+      "`deprecated` BOOLEAN NOT NULL, "
+      "`files_modified` INTEGER NOT NULL DEFAULT 0, "
+      "`files_size` INTEGER NOT NULL DEFAULT 0"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS packages_tr ("
@@ -207,7 +216,9 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
-      "`deprecated` BOOLEAN NOT NULL"
+      "`deprecated` BOOLEAN NOT NULL, "
+      "`files_modified` INTEGER NOT NULL DEFAULT 0, "
+      "`files_size` INTEGER NOT NULL DEFAULT 0"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS components_tr ("
@@ -239,7 +250,9 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "`version` TEXT NOT NULL, "
       "`deprecated` BOOLEAN NOT NULL, "
       "`component_uuid` TEXT NOT NULL, "
-      "`package_uuid` TEXT NOT NULL"
+      "`package_uuid` TEXT NOT NULL, "
+      "`files_modified` INTEGER NOT NULL DEFAULT 0, "
+      "`files_size` INTEGER NOT NULL DEFAULT 0"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS devices_tr ("
@@ -266,6 +279,22 @@ void WorkspaceLibraryDbWriter::createAllTables() {
     QSqlQuery query = mDb.prepareQuery(string);
     mDb.exec(query);
   }
+
+  // full-text search indices
+  try {
+    createSearchIndex(getElementTable<Library>());
+    createSearchIndex(getElementTable<ComponentCategory>());
+    createSearchIndex(getElementTable<PackageCategory>());
+    createSearchIndex(getElementTable<Symbol>());
+    createSearchIndex(getElementTable<Package>());
+    createSearchIndex(getElementTable<Component>());
+    createSearchIndex(getElementTable<Device>());
+  } catch (const Exception& e) {
+    // The FTS5 extension is optional in SQLite, so it might not be available.
+    qWarning() << "Failed to create full-text search index, falling back to "
+                  "slow search:"
+               << e.getMsg();
+  }
 }
 
 void WorkspaceLibraryDbWriter::addInternalData(const QString& key, int value) {
@@ -396,6 +425,47 @@ QString WorkspaceLibraryDbWriter::getCategoryTable<Device>() noexcept {
  *  Private Methods
  ******************************************************************************/
 
+void WorkspaceLibraryDbWriter::createSearchIndex(const QString& elementsTable) {
+  // The index references the translations table as external content, thus
+  // it only stores the index itself but not a copy of the texts. Triggers
+  // keep the index up to date, also on cascaded deletions.
+  const QStringList queries = {
+      "CREATE VIRTUAL TABLE IF NOT EXISTS %elements_fts USING fts5("
+      "name, description, keywords, "
+      "content='%elements_tr', content_rowid='id', "
+      "tokenize='unicode61 remove_diacritics 1', prefix='2 3'"
+      ")",
+      "CREATE TRIGGER IF NOT EXISTS %elements_tr_ai "
+      "AFTER INSERT ON %elements_tr BEGIN "
+      "INSERT INTO %elements_fts (rowid, name, description, keywords) "
+      "VALUES (new.id, new.name, new.description, new.keywords); "
+      "END",
+      "CREATE TRIGGER IF NOT EXISTS %elements_tr_ad "
+      "AFTER DELETE ON %elements_tr BEGIN "
+      "INSERT INTO %elements_fts "
+      "(%elements_fts, rowid, name, description, keywords) "
+      "VALUES ('delete', old.id, old.name, old.description, old.keywords); "
+      "END",
+      "CREATE TRIGGER IF NOT EXISTS %elements_tr_au "
+      "AFTER UPDATE ON %elements_tr BEGIN "
+      "INSERT INTO %elements_fts "
+      "(%elements_fts, rowid, name, description, keywords) "
+      "VALUES ('delete', old.id, old.name, old.description, old.keywords); "
+      "INSERT INTO %elements_fts (rowid, name, description, keywords) "
+      "VALUES (new.id, new.name, new.description, new.keywords); "
+      "END",
+  };
+  SQLiteDatabase::TransactionScopeGuard transactionGuard(mDb);  // can throw
+  foreach (const QString& string, queries) {
+    QSqlQuery query = mDb.prepareQuery(string,
+                                       {
+                                           {"%elements", elementsTable},
+                                       });
+    mDb.exec(query);  // can throw
+  }
+  transactionGuard.commit();  // can throw
+}
+
 int WorkspaceLibraryDbWriter::addElement(const QString& elementsTable,
                                          int libId, const FilePath& fp,
                                          const Uuid& uuid,
@@ -439,6 +509,23 @@ int WorkspaceLibraryDbWriter::addCategory(const QString& categoriesTable,
   return mDb.insert(query);
 }
 
+void WorkspaceLibraryDbWriter::setFilesState(const QString& elementsTable,
+                                             int elementId,
+                                             qint64 lastModified,
+                                             qint64 size) {
+  QSqlQuery query = mDb.prepareQuery(
+      "UPDATE %elements "
+      "SET files_modified = :files_modified, files_size = :files_size "
+      "WHERE id = :id",
+      {
+          {"%elements", elementsTable},
+      });
+  query.bindValue(":id", elementId);
+  query.bindValue(":files_modified", lastModified);
+  query.bindValue(":files_size", size);
+  mDb.exec(query);
+}
+
 void WorkspaceLibraryDbWriter::removeElement(const QString& elementsTable,
                                              const FilePath& fp) {
   QSqlQuery query = mDb.prepareQuery(
@@ -66,6 +66,10 @@ public:
    * @brief Create all tables to initialize the database
    *
    * This has to be done only once, after creating a new database.
+   *
+   * @note  If the SQLite library does not provide the FTS5 extension, the
+   *        full-text search tables are not created. In that case
+   *        ::librepcb::WorkspaceLibraryDb falls back to a slower search.
    */
   void createAllTables();
 
@@ -164,6 +168,26 @@ public:
                 const Version& version, bool deprecated, const Uuid& component,
                 const Uuid& package);
 
+  /**
+   * @brief Set the state of the files of a library element
+   *
+   * This is used by the library scanner to detect whether an element has
+   * been modified since it was added to the database. Elements added without
+   * calling this method have a file state of zero, thus they are always
+   * considered as modified.
+   *
+   * @tparam ElementType  Type of element to update.
+   * @param elementId     ID of the element to update.
+   * @param lastModified  Latest modification time of all element files, in
+   *                      milliseconds since epoch.
+   * @param size          Total size of all element files, in bytes.
+   */
+  template <typename ElementType>
+  void setFilesState(int elementId, qint64 lastModified, qint64 size) {
+    setFilesState(getElementTable<ElementType>(), elementId, lastModified,
+                  size);
+  }
+
   /**
    * @brief Remove a library element
    *
@@ -265,11 +289,14 @@ public:
       delete;
 
 private:  // Methods
+  void createSearchIndex(const QString& elementsTable);
   int addElement(const QString& elementsTable, int libId, const FilePath& fp,
                  const Uuid& uuid, const Version& version, bool deprecated);
   int addCategory(const QString& categoriesTable, int libId, const FilePath& fp,
                   const Uuid& uuid, const Version& version, bool deprecated,
                   const tl::optional<Uuid>& parent);
+  void setFilesState(const QString& elementsTable, int elementId,
+                     qint64 lastModified, qint64 size);
   void removeElement(const QString& elementsTable, const FilePath& fp);
   void removeAllElements(const QString& elementsTable);
   int addTranslation(const QString& elementsTable, int elementId,
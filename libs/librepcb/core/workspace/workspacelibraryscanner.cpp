@@ -28,13 +28,16 @@
 #include "../library/cmp/component.h"
 #include "../library/dev/device.h"
 #include "../library/library.h"
+#include "../library/libraryelementmetadata.h"
 #include "../library/pkg/package.h"
 #include "../library/sym/symbol.h"
 #include "../sqlitedatabase.h"
 #include "../utils/toolbox.h"
 #include "workspacelibrarydbwriter.h"
 
+#include <QtConcurrent>
 #include <QtCore>
+#include <QtSql>
 
 /*******************************************************************************
  *  Namespace
@@ -127,15 +130,15 @@ void WorkspaceLibraryScanner::scan() noexcept {
     // begin database transaction
     SQLiteDatabase::TransactionScopeGuard transactionGuard(db);  // can throw
 
-    // clear all tables
-    writer.removeAllElements<ComponentCategory>();
-    writer.removeAllElements<PackageCategory>();
-    writer.removeAllElements<Symbol>();
-    writer.removeAllElements<Package>();
-    writer.removeAllElements<Component>();
-    writer.removeAllElements<Device>();
+    // get all elements currently in the database
+    DbElements cmpCats = getElementsFromDb<ComponentCategory>(db);
+    DbElements pkgCats = getElementsFromDb<PackageCategory>(db);
+    DbElements symbols = getElementsFromDb<Symbol>(db);
+    DbElements packages = getElementsFromDb<Package>(db);
+    DbElements components = getElementsFromDb<Component>(db);
+    DbElements devices = getElementsFromDb<Device>(db);
 
-    // scan all libraries
+    // scan all libraries and update only the modified elements in the database
     int count = 0;
     qreal percent = 1;
     foreach (const std::shared_ptr<Library>& lib, libraries) {
@@ -143,31 +146,44 @@ void WorkspaceLibraryScanner::scan() noexcept {
       Q_ASSERT(libIds.contains(fp));
       int libId = libIds[fp];
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<ComponentCategory>(
-          writer, fs, fp, lib->searchForElements<ComponentCategory>(), libId);
+      count += updateElementsInDb<ComponentCategory>(
+          writer, fp, lib->searchForElements<ComponentCategory>(), libId,
+          cmpCats);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<PackageCategory>(
-          writer, fs, fp, lib->searchForElements<PackageCategory>(), libId);
+      count += updateElementsInDb<PackageCategory>(
+          writer, fp, lib->searchForElements<PackageCategory>(), libId,
+          pkgCats);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Symbol>(writer, fs, fp,
-                                       lib->searchForElements<Symbol>(), libId);
+      count += updateElementsInDb<Symbol>(
+          writer, fp, lib->searchForElements<Symbol>(), libId, symbols);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Package>(
-          writer, fs, fp, lib->searchForElements<Package>(), libId);
+      count += updateElementsInDb<Package>(
+          writer, fp, lib->searchForElements<Package>(), libId, packages);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Component>(
-          writer, fs, fp, lib->searchForElements<Component>(), libId);
+      count += updateElementsInDb<Component>(
+          writer, fp, lib->searchForElements<Component>(), libId,
+          components);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Device>(writer, fs, fp,
-                                       lib->searchForElements<Device>(), libId);
+      count += updateElementsInDb<Device>(
+          writer, fp, lib->searchForElements<Device>(), libId, devices);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
     }
 
+    // remove elements from database which do no longer exist
+    if ((!mAbort) && (mSemaphore.available() == 0)) {
+      removeElementsFromDb<ComponentCategory>(writer, cmpCats);
+      removeElementsFromDb<PackageCategory>(writer, pkgCats);
+      removeElementsFromDb<Symbol>(writer, symbols);
+      removeElementsFromDb<Package>(writer, packages);
+      removeElementsFromDb<Component>(writer, components);
+      removeElementsFromDb<Device>(writer, devices);
+    }
+
     // commit transaction
     if ((!mAbort) && (mSemaphore.available() == 0)) {
       transactionGuard.commit();  // can throw
@@ -257,7 +273,7 @@ QHash<FilePath, int> WorkspaceLibraryScanner::updateLibraries(
   foreach (const std::shared_ptr<Library>& lib, libs) {
     int id = dbLibIds.value(lib->getDirectory().getAbsPath());
     Q_ASSERT(id >= 0);
-    addTranslationsToDb(writer, id, *lib);
+    addTranslationsToDb<Library>(writer, id, *lib);
   }
 
   transactionGuard.commit();  // can throw
@@ -265,75 +281,155 @@ QHash<FilePath, int> WorkspaceLibraryScanner::updateLibraries(
 }
 
 template <typename ElementType>
-int WorkspaceLibraryScanner::addElementsToDb(
-    WorkspaceLibraryDbWriter& writer,
-    std::shared_ptr<TransactionalFileSystem> fs, const FilePath& libPath,
-    const QStringList& dirs, int libId) {
+WorkspaceLibraryScanner::DbElements WorkspaceLibraryScanner::getElementsFromDb(
+    SQLiteDatabase& db) {
+  DbElements elements;
+  QSqlQuery query = db.prepareQuery(
+      "SELECT id, filepath, files_modified, files_size FROM %elements",
+      {
+          {"%elements",
+           WorkspaceLibraryDbWriter::getElementTable<ElementType>()},
+      });
+  db.exec(query);
+  while (query.next()) {
+    FilePath fp = mLibrariesPath.getPathTo(query.value(1).toString());
+    if (!fp.isValid()) throw LogicError(__FILE__, __LINE__);
+    DbElement element;
+    element.id = query.value(0).toInt();
+    element.files.lastModified = query.value(2).toLongLong();
+    element.files.size = query.value(3).toLongLong();
+    elements.insert(fp, element);
+  }
+  return elements;
+}
+
+template <typename ElementType>
+int WorkspaceLibraryScanner::updateElementsInDb(
+    WorkspaceLibraryDbWriter& writer, const FilePath& libPath,
+    const QStringList& dirs, int libId, DbElements& dbElements) {
+  typedef std::pair<FilePath, FilesState> Item;
+
+  // Determine which elements need to be (re-)opened.
   int count = 0;
+  QVector<Item> modifiedElements;
   foreach (const QString& dirpath, dirs) {
-    if (mAbort || (mSemaphore.available() > 0)) break;
+    if (mAbort || (mSemaphore.available() > 0)) return count;
     FilePath absPath = libPath.getPathTo(dirpath);
-    QString relPath = absPath.toRelative(fs->getAbsPath());
-    try {
-      std::unique_ptr<TransactionalDirectory> dir(
-          new TransactionalDirectory(fs, relPath));  // can throw
-      std::unique_ptr<ElementType> element =
-          ElementType::open(std::move(dir));  // can throw
-      int id = addElementToDb(writer, libId, *element);
-      addTranslationsToDb(writer, id, *element);
-      count++;
-    } catch (const Exception& e) {
-      qWarning() << "Failed to open library element during scan:"
-                 << absPath.toNative();
+    const FilesState files = getFilesState(absPath);
+
+    // Skip elements which are unchanged since the last scan. The library ID
+    // does not need to be compared since it is implied by the filepath.
+    auto it = dbElements.find(absPath);
+    if (it != dbElements.end()) {
+      const bool modified = (it->files.lastModified != files.lastModified) ||
+          (it->files.size != files.size);
+      dbElements.erase(it);
+      if (!modified) {
+        count++;
+        continue;
+      }
+      writer.removeElement<ElementType>(absPath);
+    }
+    modifiedElements.append(std::make_pair(absPath, files));
+  }
+
+  // Load the metadata of the modified elements in worker threads, while
+  // adding the already loaded elements to the database in this thread. Only
+  // the metadata is loaded since the content (e.g. footprints) is not
+  // indexed. Each element gets its own file system since file format
+  // migrations modify it, which is not thread-safe. Elements are processed in
+  // batches to limit memory usage.
+  typedef std::shared_ptr<const LibraryElementMetadata> Metadata;
+  std::function<Metadata(const Item&)> open =
+      [this](const Item& item) -> Metadata {
+        Metadata element;
+        if (mAbort || (mSemaphore.available() > 0)) return element;
+        try {
+          TransactionalDirectory dir(
+              TransactionalFileSystem::openRO(item.first));  // can throw
+          element = std::make_shared<LibraryElementMetadata>(
+              LibraryElementMetadata::open<ElementType>(dir));  // can throw
+        } catch (const Exception& e) {
+          qWarning() << "Failed to open library element during scan:"
+                     << item.first.toNative();
+        }
+        return element;
+      };
+  const int batchSize = 256;
+  for (int first = 0; first < modifiedElements.count(); first += batchSize) {
+    const QVector<Item> batch = modifiedElements.mid(first, batchSize);
+    QFuture<Metadata> future = QtConcurrent::mapped(batch, open);
+    for (int i = 0; i < batch.count(); ++i) {
+      if (mAbort || (mSemaphore.available() > 0)) break;
+      const Metadata element = future.resultAt(i);
+      if (element) {
+        const int id = addElementToDb<ElementType>(writer, libId, *element);
+        addTranslationsToDb<ElementType>(writer, id, *element);
+        writer.setFilesState<ElementType>(id, batch.at(i).second.lastModified,
+                                          batch.at(i).second.size);
+        count++;
+      }
     }
+    future.cancel();
+    future.waitForFinished();
+    if (mAbort || (mSemaphore.available() > 0)) break;
   }
   return count;
 }
 
 template <typename ElementType>
-int WorkspaceLibraryScanner::addElementToDb(WorkspaceLibraryDbWriter& writer,
-                                            int libId,
-                                            const ElementType& element) {
+void WorkspaceLibraryScanner::removeElementsFromDb(
+    WorkspaceLibraryDbWriter& writer, const DbElements& dbElements) {
+  for (auto it = dbElements.begin(); it != dbElements.end(); ++it) {
+    writer.removeElement<ElementType>(it.key());
+  }
+}
+
+template <typename ElementType>
+int WorkspaceLibraryScanner::addElementToDb(
+    WorkspaceLibraryDbWriter& writer, int libId,
+    const LibraryElementMetadata& element) {
   const int id = writer.addElement<ElementType>(
-      libId, element.getDirectory().getAbsPath(), element.getUuid(),
-      element.getVersion(), element.isDeprecated());
-  addToCategories(writer, id, element);
+      libId, element.getDirectory(), element.getUuid(), element.getVersion(),
+      element.isDeprecated());
+  addToCategories<ElementType>(writer, id, element);
   return id;
 }
 
 template <>
 int WorkspaceLibraryScanner::addElementToDb<ComponentCategory>(
     WorkspaceLibraryDbWriter& writer, int libId,
-    const ComponentCategory& element) {
+    const LibraryElementMetadata& element) {
   return writer.addCategory<ComponentCategory>(
-      libId, element.getDirectory().getAbsPath(), element.getUuid(),
-      element.getVersion(), element.isDeprecated(), element.getParentUuid());
+      libId, element.getDirectory(), element.getUuid(), element.getVersion(),
+      element.isDeprecated(), element.getParentUuid());
 }
 
 template <>
 int WorkspaceLibraryScanner::addElementToDb<PackageCategory>(
     WorkspaceLibraryDbWriter& writer, int libId,
-    const PackageCategory& element) {
+    const LibraryElementMetadata& element) {
   return writer.addCategory<PackageCategory>(
-      libId, element.getDirectory().getAbsPath(), element.getUuid(),
-      element.getVersion(), element.isDeprecated(), element.getParentUuid());
+      libId, element.getDirectory(), element.getUuid(), element.getVersion(),
+      element.isDeprecated(), element.getParentUuid());
 }
 
 template <>
 int WorkspaceLibraryScanner::addElementToDb<Device>(
-    WorkspaceLibraryDbWriter& writer, int libId, const Device& element) {
+    WorkspaceLibraryDbWriter& writer, int libId,
+    const LibraryElementMetadata& element) {
+  Q_ASSERT(element.getComponentUuid() && element.getPackageUuid());
   const int id = writer.addDevice(
-      libId, element.getDirectory().getAbsPath(), element.getUuid(),
-      element.getVersion(), element.isDeprecated(), element.getComponentUuid(),
-      element.getPackageUuid());
-  addToCategories(writer, id, element);
+      libId, element.getDirectory(), element.getUuid(), element.getVersion(),
+      element.isDeprecated(), *element.getComponentUuid(),
+      *element.getPackageUuid());
+  addToCategories<Device>(writer, id, element);
   return id;
 }
 
-template <typename ElementType>
+template <typename ElementType, typename T>
 void WorkspaceLibraryScanner::addTranslationsToDb(
-    WorkspaceLibraryDbWriter& writer, int elementId,
-    const ElementType& element) {
+    WorkspaceLibraryDbWriter& writer, int elementId, const T& element) {
   foreach (const QString& locale, element.getAllAvailableLocales()) {
     writer.addTranslation<ElementType>(elementId, locale,
                                        element.getNames().tryGet(locale),
@@ -343,14 +439,31 @@ void WorkspaceLibraryScanner::addTranslationsToDb(
 }
 
 template <typename ElementType>
-void WorkspaceLibraryScanner::addToCategories(WorkspaceLibraryDbWriter& writer,
-                                              int elementId,
-                                              const ElementType& element) {
+void WorkspaceLibraryScanner::addToCategories(
+    WorkspaceLibraryDbWriter& writer, int elementId,
+    const LibraryElementMetadata& element) {
   foreach (const Uuid& category, element.getCategories()) {
     writer.addToCategory<ElementType>(elementId, category);
   }
 }
 
+WorkspaceLibraryScanner::FilesState WorkspaceLibraryScanner::getFilesState(
+    const FilePath& dir) noexcept {
+  // Note: The modification time of the directory itself is not sufficient
+  // since it does not change when existing files are overwritten.
+  FilesState state{0, 0};
+  QDirIterator it(dir.toStr(), QDir::Files | QDir::Hidden,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    it.next();
+    const QFileInfo info = it.fileInfo();
+    state.lastModified =
+        std::max(state.lastModified, info.lastModified().toMSecsSinceEpoch());
+    state.size += info.size();
+  }
+  return state;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -35,6 +35,7 @@
 namespace librepcb {
 
 class Library;
+class LibraryElementMetadata;
 class SQLiteDatabase;
 class TransactionalFileSystem;
 class WorkspaceLibraryDbWriter;
@@ -78,6 +79,17 @@ signals:
   void scanFailed(QString errorMsg);
   void scanFinished();
 
+private:  // Types
+  struct FilesState {
+    qint64 lastModified;
+    qint64 size;
+  };
+  struct DbElement {
+    int id;
+    FilesState files;
+  };
+  typedef QHash<FilePath, DbElement> DbElements;
+
 private:  // Methods
   void run() noexcept override;
   void scan() noexcept;
@@ -88,19 +100,24 @@ private:  // Methods
       SQLiteDatabase& db, WorkspaceLibraryDbWriter& writer,
       const QList<std::shared_ptr<Library>>& libs);
   template <typename ElementType>
-  int addElementsToDb(WorkspaceLibraryDbWriter& writer,
-                      std::shared_ptr<TransactionalFileSystem> fs,
-                      const FilePath& libPath, const QStringList& dirs,
-                      int libId);
+  DbElements getElementsFromDb(SQLiteDatabase& db);
   template <typename ElementType>
-  int addElementToDb(WorkspaceLibraryDbWriter& writer, int libId,
-                     const ElementType& element);
+  int updateElementsInDb(WorkspaceLibraryDbWriter& writer,
+                         const FilePath& libPath, const QStringList& dirs,
+                         int libId, DbElements& dbElements);
   template <typename ElementType>
+  void removeElementsFromDb(WorkspaceLibraryDbWriter& writer,
+                            const DbElements& dbElements);
+  template <typename ElementType>
+  int addElementToDb(WorkspaceLibraryDbWriter& writer, int libId,
+                     const LibraryElementMetadata& element);
+  template <typename ElementType, typename T>
   void addTranslationsToDb(WorkspaceLibraryDbWriter& writer, int elementId,
-                           const ElementType& element);
+                           const T& element);
   template <typename ElementType>
   void addToCategories(WorkspaceLibraryDbWriter& writer, int elementId,
-                       const ElementType& element);
+                       const LibraryElementMetadata& element);
+  static FilesState getFilesState(const FilePath& dir) noexcept;
 
 private:  // Data
   const FilePath mLibrariesPath;  ///< Path to workspace libraries directory.
@@ -306,6 +306,17 @@ void BoardEditor::boardAdded(int newIndex) {
 void BoardEditor::boardRemoved(int oldIndex) {
   mUi->tabBar->removeTab(oldIndex);  // calls setActiveBoardIndex() if needed
 
+  // The DRC cache refers to items of the removed board, so discard it.
+  QSet<Uuid> boardUuids;
+  foreach (const Board* board, mProject.getBoards()) {
+    boardUuids.insert(board->getUuid());
+  }
+  foreach (const Uuid& uuid, mDrcCaches.keys()) {
+    if (!boardUuids.contains(uuid)) {
+      mDrcCaches.remove(uuid);
+    }
+  }
+
   // To avoid wasting space, only show the tab bar if there are multiple boards.
   mUi->tabBar->setVisible(mUi->tabBar->count() > 1);
 }
@@ -1044,7 +1055,14 @@ void BoardEditor::runDrcNonInteractive() noexcept {
   bool wasInteractive = mDockDrc->setInteractive(false);
 
   try {
+    // Use a cache to only check the modified areas of the board again.
+    std::shared_ptr<BoardDesignRuleCheck::Cache>& cache =
+        mDrcCaches[board->getUuid()];
+    if (!cache) {
+      cache = std::make_shared<BoardDesignRuleCheck::Cache>();
+    }
     BoardDesignRuleCheck drc(*board, mDrcOptions);
+    drc.setCache(cache);
     connect(&drc, &BoardDesignRuleCheck::progressPercent, mDockDrc.data(),
             &BoardDesignRuleCheckMessagesDock::setProgressPercent);
     connect(&drc, &BoardDesignRuleCheck::progressStatus, mDockDrc.data(),
@@ -150,6 +150,8 @@ private:
   BoardDesignRuleCheck::Options mDrcOptions;
   QHash<Uuid, QList<BoardDesignRuleCheckMessage>>
       mDrcMessages;  ///< Key: Board UUID
+  QHash<Uuid, std::shared_ptr<BoardDesignRuleCheck::Cache>>
+      mDrcCaches;  ///< Key: Board UUID
   QScopedPointer<QGraphicsPathItem> mDrcLocationGraphicsItem;
 
   // Misc
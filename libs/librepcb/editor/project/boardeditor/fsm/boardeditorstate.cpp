@@ -146,6 +146,14 @@ QList<BI_Base*> BoardEditorState::findItemsAtPos(
   const QPainterPath posAreaLarge =
       mContext.editorGraphicsView.calcPosWithTolerance(pos, 1.5);
 
+  // Only items close to the cursor need to be tested with their exact shape,
+  // so get them from the spatial index of the graphics scene first.
+  QRectF searchAreaPx = posAreaLarge.boundingRect();
+  if (flags.testFlag(FindFlag::AcceptNextGridMatch)) {
+    searchAreaPx |= QRectF(posExact, posOnGrid).normalized();
+  }
+  const QSet<BI_Base*> candidates = board->getItemsInRect(searchAreaPx);
+
   // Note: The order of adding the items is very important (the top most item
   // must appear as the first item in the list)! For that, we work with
   // priorities (0 = highest priority):
@@ -211,9 +219,9 @@ QList<BI_Base*> BoardEditorState::findItemsAtPos(
     }
   };
   auto processItem = [&pos, &posExact, &posOnGrid, &posArea, &posAreaLarge,
-                      flags, &except, &addItem,
-                      &canSkip](BI_Base* item, const Point& nearestPos,
-                                int priority, bool large = false) {
+                      flags, &except, &addItem, &canSkip](
+                         BI_Base* item, const Point& nearestPos, int priority,
+                         bool large = false) {
     if (except.contains(item) || (!item->isSelectable())) {
       return;
     }
@@ -251,40 +259,51 @@ QList<BI_Base*> BoardEditorState::findItemsAtPos(
     }
   };
 
-  if (flags.testFlag(FindFlag::Holes)) {
-    foreach (BI_Hole* hole, board->getHoles()) {
-      processItem(hole,
-                  hole->getHole().getPath()->getVertices().first().getPos(), 5);
-    }
-  }
-
-  if (flags & (FindFlag::Vias | FindFlag::NetPoints | FindFlag::NetLines)) {
-    foreach (BI_NetSegment* segment, board->getNetSegments()) {
-      if ((!netsignals.isEmpty()) &&
-          (!netsignals.contains(segment->getNetSignal()))) {
-        continue;
+  // Only the candidates found in the spatial index need to be processed, so
+  // the costs do not depend on the total number of items on the board.
+  auto acceptNetSignal = [&netsignals](const NetSignal* netsignal) {
+    return netsignals.isEmpty() || netsignals.contains(netsignal);
+  };
+  foreach (BI_Base* item, candidates) {
+    switch (item->getType()) {
+      case BI_Base::Type_t::Hole: {
+        BI_Hole* hole = dynamic_cast<BI_Hole*>(item);
+        Q_ASSERT(hole);
+        if (flags.testFlag(FindFlag::Holes)) {
+          processItem(
+              hole, hole->getHole().getPath()->getVertices().first().getPos(),
+              5);
+        }
+        break;
       }
-      if (flags.testFlag(FindFlag::Vias)) {
-        foreach (BI_Via* via, segment->getVias()) {
+      case BI_Base::Type_t::Via: {
+        BI_Via* via = dynamic_cast<BI_Via*>(item);
+        Q_ASSERT(via);
+        if (flags.testFlag(FindFlag::Vias) &&
+            acceptNetSignal(via->getNetSegment().getNetSignal())) {
           processItem(via, via->getPosition(), 0);
         }
+        break;
       }
-      if (flags.testFlag(FindFlag::NetPoints)) {
-        foreach (BI_NetPoint* netpoint, segment->getNetPoints()) {
-          const GraphicsLayer* layer = netpoint->getLayerOfLines();
-          if (cuLayer && (layer != cuLayer)) {
-            continue;
-          }
+      case BI_Base::Type_t::NetPoint: {
+        BI_NetPoint* netpoint = dynamic_cast<BI_NetPoint*>(item);
+        Q_ASSERT(netpoint);
+        const GraphicsLayer* layer = netpoint->getLayerOfLines();
+        if (flags.testFlag(FindFlag::NetPoints) &&
+            acceptNetSignal(netpoint->getNetSegment().getNetSignal()) &&
+            ((!cuLayer) || (layer == cuLayer))) {
           processItem(netpoint, netpoint->getPosition(),
                       10 + (layer ? priorityFromLayer(layer->getName()) : 0));
         }
+        break;
       }
-      if (flags.testFlag(FindFlag::NetLines)) {
-        foreach (BI_NetLine* netline, segment->getNetLines()) {
-          const GraphicsLayer& layer = netline->getLayer();
-          if (cuLayer && (&layer != cuLayer)) {
-            continue;
-          }
+      case BI_Base::Type_t::NetLine: {
+        BI_NetLine* netline = dynamic_cast<BI_NetLine*>(item);
+        Q_ASSERT(netline);
+        const GraphicsLayer& layer = netline->getLayer();
+        if (flags.testFlag(FindFlag::NetLines) &&
+            acceptNetSignal(netline->getNetSegment().getNetSignal()) &&
+            ((!cuLayer) || (&layer == cuLayer))) {
           processItem(netline,
                       Toolbox::nearestPointOnLine(
                           pos.mappedToGrid(getGridInterval()),
@@ -292,70 +311,63 @@ QList<BI_Base*> BoardEditorState::findItemsAtPos(
                           netline->getEndPoint().getPosition()),
                       20 + priorityFromLayer(layer.getName()));
         }
+        break;
       }
-    }
-  }
-
-  if (flags.testFlag(FindFlag::Planes)) {
-    foreach (BI_Plane* plane, board->getPlanes()) {
-      if ((!netsignals.isEmpty()) &&
-          (!netsignals.contains(&plane->getNetSignal()))) {
-        continue;
-      }
-      if (cuLayer && (*plane->getLayerName() != cuLayer->getName())) {
-        continue;
+      case BI_Base::Type_t::Plane: {
+        BI_Plane* plane = dynamic_cast<BI_Plane*>(item);
+        Q_ASSERT(plane);
+        if (flags.testFlag(FindFlag::Planes) &&
+            acceptNetSignal(&plane->getNetSignal()) &&
+            ((!cuLayer) || (*plane->getLayerName() == cuLayer->getName()))) {
+          processItem(plane,
+                      plane->getOutline().calcNearestPointBetweenVertices(pos),
+                      30 + priorityFromLayer(*plane->getLayerName()),
+                      true);  // Probably large grab area makes sense?
+        }
+        break;
       }
-      processItem(plane,
-                  plane->getOutline().calcNearestPointBetweenVertices(pos),
-                  30 + priorityFromLayer(*plane->getLayerName()),
-                  true);  // Probably large grab area makes sense?
-    }
-  }
-
-  if (flags &
-      (FindFlag::Footprints | FindFlag::FootprintPads |
-       FindFlag::StrokeTexts)) {
-    foreach (BI_Device* device, board->getDeviceInstances()) {
-      if (flags.testFlag(FindFlag::Footprints)) {
-        processItem(device, device->getPosition(),
-                    40 + (device->getMirrored() ? 300 : 100));
+      case BI_Base::Type_t::Device: {
+        BI_Device* device = dynamic_cast<BI_Device*>(item);
+        Q_ASSERT(device);
+        if (flags.testFlag(FindFlag::Footprints)) {
+          processItem(device, device->getPosition(),
+                      40 + (device->getMirrored() ? 300 : 100));
+        }
+        break;
       }
-      if (flags.testFlag(FindFlag::FootprintPads)) {
-        foreach (BI_FootprintPad* pad, device->getPads()) {
-          if ((!netsignals.isEmpty()) &&
-              (!netsignals.contains(pad->getCompSigInstNetSignal()))) {
-            continue;
-          }
-          if (cuLayer && (!pad->isOnLayer(cuLayer->getName()))) {
-            continue;
-          }
+      case BI_Base::Type_t::FootprintPad: {
+        BI_FootprintPad* pad = dynamic_cast<BI_FootprintPad*>(item);
+        Q_ASSERT(pad);
+        if (flags.testFlag(FindFlag::FootprintPads) &&
+            acceptNetSignal(pad->getCompSigInstNetSignal()) &&
+            ((!cuLayer) || pad->isOnLayer(cuLayer->getName()))) {
           processItem(pad, pad->getPosition(),
                       50 + (pad->getMirrored() ? 300 : 100));
         }
+        break;
+      }
+      case BI_Base::Type_t::Polygon: {
+        BI_Polygon* polygon = dynamic_cast<BI_Polygon*>(item);
+        Q_ASSERT(polygon);
+        const Polygon& p = polygon->getPolygon();
+        if (flags.testFlag(FindFlag::Polygons)) {
+          processItem(polygon, p.getPath().calcNearestPointBetweenVertices(pos),
+                      60 + priorityFromLayer(*p.getLayerName()),
+                      true);  // Probably large grab area makes sense?
+        }
+        break;
       }
-      if (flags.testFlag(FindFlag::StrokeTexts)) {
-        foreach (BI_StrokeText* text, device->getStrokeTexts()) {
+      case BI_Base::Type_t::StrokeText: {
+        BI_StrokeText* text = dynamic_cast<BI_StrokeText*>(item);
+        Q_ASSERT(text);
+        if (flags.testFlag(FindFlag::StrokeTexts)) {
           processItem(text, text->getPosition(),
                       60 + priorityFromLayer(*text->getText().getLayerName()));
         }
+        break;
       }
-    }
-  }
-
-  if (flags.testFlag(FindFlag::Polygons)) {
-    foreach (BI_Polygon* polygon, board->getPolygons()) {
-      processItem(
-          polygon,
-          polygon->getPolygon().getPath().calcNearestPointBetweenVertices(pos),
-          60 + priorityFromLayer(*polygon->getPolygon().getLayerName()),
-          true);  // Probably large grab area makes sense?
-    }
-  }
-
-  if (flags.testFlag(FindFlag::StrokeTexts)) {
-    foreach (BI_StrokeText* text, board->getStrokeTexts()) {
-      processItem(text, text->getPosition(),
-                  60 + priorityFromLayer(*text->getText().getLayerName()));
+      default:
+        break;
     }
   }
 
@@ -171,8 +171,10 @@ void CmdBoardPlaneEdit::performUndo() {
   mPlane.setPriority(mOldPriority);
   mPlane.setKeepOrphans(mOldKeepOrphans);
 
-  // rebuild all planes to see the changes
-  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
+  // rebuild all planes affected by the changes
+  if (mDoRebuildOnChanges) {
+    mPlane.getBoard().rebuildPlanes({mOldOutline, mNewOutline});
+  }
 }
 
 void CmdBoardPlaneEdit::performRedo() {
@@ -185,8 +187,10 @@ void CmdBoardPlaneEdit::performRedo() {
   mPlane.setPriority(mNewPriority);
   mPlane.setKeepOrphans(mNewKeepOrphans);
 
-  // rebuild all planes to see the changes
-  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
+  // rebuild all planes affected by the changes
+  if (mDoRebuildOnChanges) {
+    mPlane.getBoard().rebuildPlanes({mOldOutline, mNewOutline});
+  }
 }
 
 /*******************************************************************************
@@ -57,7 +57,8 @@ ProjectEditor::ProjectEditor(
     mUndoStack(nullptr),
     mSchematicEditor(nullptr),
     mBoardEditor(nullptr),
-    mLastAutosaveStateId(0) {
+    mLastAutosaveStateId(0),
+    mPendingAutosaveStateId(0) {
   try {
     mUndoStack = new UndoStack();
     mLastAutosaveStateId = mUndoStack->getUniqueStateId();
@@ -83,6 +84,8 @@ ProjectEditor::ProjectEditor(
     // autosaving is enabled --> start the timer
     connect(&mAutoSaveTimer, &QTimer::timeout, this,
             &ProjectEditor::autosaveProject);
+    connect(&mAutosaveWatcher, &QFutureWatcher<void>::finished, this,
+            &ProjectEditor::autosaveFinished);
     mAutoSaveTimer.start(1000 * intervalSecs);
   }
 }
@@ -256,6 +259,7 @@ bool ProjectEditor::saveProject() noexcept {
     mProject.save();  // can throw
     mProject.getDirectory().getFileSystem()->save();  // can throw
     mLastAutosaveStateId = mUndoStack->getUniqueStateId();
+    mPendingAutosaveStateId = mLastAutosaveStateId;  // outdated anyway
 
     // saving was successful --> clean the undo stack
     mUndoStack->setClean();
@@ -279,19 +283,23 @@ bool ProjectEditor::autosaveProject() noexcept {
     return false;
   }
 
-  if (mUndoStack->isCommandGroupActive()) {
-    // the user is executing a command at the moment, so we should not save now,
-    // try it a few seconds later instead...
+  if (mUndoStack->isCommandGroupActive() || mAutosaveWatcher.isRunning()) {
+    // the user is executing a command at the moment or the previous autosave
+    // is still in progress, so we should not save now, try it a few seconds
+    // later instead...
     QTimer::singleShot(10000, this, &ProjectEditor::autosaveProject);
     return false;
   }
 
   try {
+    // Only serialize the project in this thread since the project must not be
+    // accessed from other threads. Writing the autosave backup to the disk is
+    // done in background.
     qDebug() << "Autosave project...";
     mProject.save();  // can throw
-    mProject.getDirectory().getFileSystem()->autosave();  // can throw
-    mLastAutosaveStateId = mUndoStack->getUniqueStateId();
-    qDebug() << "Successfully autosaved project.";
+    mPendingAutosaveStateId = mUndoStack->getUniqueStateId();
+    mAutosaveWatcher.setFuture(
+        mProject.getDirectory().getFileSystem()->autosaveAsync());  // can throw
     return true;
   } catch (Exception& exc) {
     return false;
@@ -350,6 +358,18 @@ int ProjectEditor::getCountOfVisibleEditorWindows() const noexcept {
   return count;
 }
 
+void ProjectEditor::autosaveFinished() noexcept {
+  try {
+    mAutosaveWatcher.future().waitForFinished();  // can throw
+    mLastAutosaveStateId = mPendingAutosaveStateId;
+    qDebug() << "Successfully autosaved project.";
+  } catch (Exception& exc) {
+    qWarning() << "Failed to autosave project:" << exc.getMsg();
+  } catch (...) {
+    qWarning() << "Failed to autosave project: Unknown error.";
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
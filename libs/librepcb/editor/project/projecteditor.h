@@ -233,6 +233,7 @@ signals:
 
 private:  // Methods
   int getCountOfVisibleEditorWindows() const noexcept;
+  void autosaveFinished() noexcept;
 
 private:  // Data
   Workspace& mWorkspace;
@@ -247,6 +248,12 @@ private:  // Data
    * The UndoStack state ID of the last successful project (auto)save
    */
   uint mLastAutosaveStateId;
+
+  /**
+   * The UndoStack state ID of the autosave currently running in background
+   */
+  uint mPendingAutosaveStateId;
+  QFutureWatcher<void> mAutosaveWatcher;
 };
 
 /*******************************************************************************
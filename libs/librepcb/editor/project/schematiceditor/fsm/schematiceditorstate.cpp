@@ -130,6 +130,14 @@ QList<SI_Base*> SchematicEditorState::findItemsAtPos(
     posAreaInGrid.addEllipse(pos.toPxQPointF(), gridDistancePx, gridDistancePx);
   }
 
+  // Only items close to the cursor need to be tested with their exact shape,
+  // so get them from the spatial index of the graphics scene first.
+  QRectF searchAreaPx = posAreaLarge.boundingRect();
+  if (flags.testFlag(FindFlag::AcceptNearestWithinGrid)) {
+    searchAreaPx |= posAreaInGrid.boundingRect();
+  }
+  const QSet<SI_Base*> candidates = schematic->getItemsInRect(searchAreaPx);
+
   // Note: The order of adding the items is very important (the top most item
   // must appear as the first item in the list)! For that, we work with
   // priorities (0 = highest priority):
@@ -160,9 +168,9 @@ QList<SI_Base*> SchematicEditorState::findItemsAtPos(
         lowestPriority && (prio > (*lowestPriority));
   };
   auto processItem = [&pos, &posExact, &posArea, &posAreaLarge, &posAreaInGrid,
-                      flags, &except, &addItem,
-                      &canSkip](SI_Base* item, const Point& nearestPos,
-                                int priority, bool large = false) {
+                      flags, &except, &addItem, &canSkip](
+                         SI_Base* item, const Point& nearestPos, int priority,
+                         bool large = false) {
     if (except.contains(item)) {
       return;
     }
@@ -201,17 +209,23 @@ QList<SI_Base*> SchematicEditorState::findItemsAtPos(
     }
   };
 
-  if (flags &
-      (FindFlag::NetPoints | FindFlag::NetLines | FindFlag::NetLabels)) {
-    foreach (SI_NetSegment* segment, schematic->getNetSegments()) {
-      if (flags.testFlag(FindFlag::NetPoints)) {
-        foreach (SI_NetPoint* netpoint, segment->getNetPoints()) {
+  // Only the candidates found in the spatial index need to be processed, so
+  // the costs do not depend on the total number of items in the schematic.
+  foreach (SI_Base* item, candidates) {
+    switch (item->getType()) {
+      case SI_Base::Type_t::NetPoint: {
+        SI_NetPoint* netpoint = dynamic_cast<SI_NetPoint*>(item);
+        Q_ASSERT(netpoint);
+        if (flags.testFlag(FindFlag::NetPoints)) {
           processItem(netpoint, netpoint->getPosition(),
                       netpoint->isVisibleJunction() ? 0 : 10);
         }
+        break;
       }
-      if (flags.testFlag(FindFlag::NetLines)) {
-        foreach (SI_NetLine* netline, segment->getNetLines()) {
+      case SI_Base::Type_t::NetLine: {
+        SI_NetLine* netline = dynamic_cast<SI_NetLine*>(item);
+        Q_ASSERT(netline);
+        if (flags.testFlag(FindFlag::NetLines)) {
           processItem(netline,
                       Toolbox::nearestPointOnLine(
                           pos.mappedToGrid(getGridInterval()),
@@ -219,51 +233,54 @@ QList<SI_Base*> SchematicEditorState::findItemsAtPos(
                           netline->getEndPoint().getPosition()),
                       20, true);  // Large grab area, better usability!
         }
+        break;
       }
-      if (flags.testFlag(FindFlag::NetLabels)) {
-        foreach (SI_NetLabel* netlabel, segment->getNetLabels()) {
+      case SI_Base::Type_t::NetLabel: {
+        SI_NetLabel* netlabel = dynamic_cast<SI_NetLabel*>(item);
+        Q_ASSERT(netlabel);
+        if (flags.testFlag(FindFlag::NetLabels)) {
           processItem(netlabel, netlabel->getPosition(), 30);
         }
+        break;
       }
-    }
-  }
-
-  if (flags &
-      (FindFlag::Symbols | FindFlag::SymbolPins |
-       FindFlag::SymbolPinsWithComponentSignal | FindFlag::Texts)) {
-    foreach (SI_Symbol* symbol, schematic->getSymbols()) {
-      if (flags.testFlag(FindFlag::Symbols)) {
-        processItem(symbol, symbol->getPosition(), 40);
+      case SI_Base::Type_t::Symbol: {
+        SI_Symbol* symbol = dynamic_cast<SI_Symbol*>(item);
+        Q_ASSERT(symbol);
+        if (flags.testFlag(FindFlag::Symbols)) {
+          processItem(symbol, symbol->getPosition(), 40);
+        }
+        break;
+      }
+      case SI_Base::Type_t::SymbolPin: {
+        SI_SymbolPin* pin = dynamic_cast<SI_SymbolPin*>(item);
+        Q_ASSERT(pin);
+        if (flags.testFlag(FindFlag::SymbolPins) ||
+            (flags.testFlag(FindFlag::SymbolPinsWithComponentSignal) &&
+             pin->getComponentSignalInstance())) {
+          processItem(pin, pin->getPosition(), 50);
+        }
+        break;
       }
-      if (flags &
-          (FindFlag::SymbolPins | FindFlag::SymbolPinsWithComponentSignal)) {
-        foreach (SI_SymbolPin* pin, symbol->getPins()) {
-          if (flags.testFlag(FindFlag::SymbolPins) ||
-              (pin->getComponentSignalInstance())) {
-            processItem(pin, pin->getPosition(), 50);
-          }
+      case SI_Base::Type_t::Polygon: {
+        SI_Polygon* polygon = dynamic_cast<SI_Polygon*>(item);
+        Q_ASSERT(polygon);
+        const Polygon& p = polygon->getPolygon();
+        if (flags.testFlag(FindFlag::Polygons)) {
+          processItem(polygon, p.getPath().calcNearestPointBetweenVertices(pos),
+                      60, true);  // Probably large grab area makes sense?
         }
+        break;
       }
-      if (flags.testFlag(FindFlag::Texts)) {
-        foreach (SI_Text* text, symbol->getTexts()) {
+      case SI_Base::Type_t::Text: {
+        SI_Text* text = dynamic_cast<SI_Text*>(item);
+        Q_ASSERT(text);
+        if (flags.testFlag(FindFlag::Texts)) {
           processItem(text, text->getPosition(), 70);
         }
+        break;
       }
-    }
-  }
-
-  if (flags.testFlag(FindFlag::Polygons)) {
-    foreach (SI_Polygon* polygon, schematic->getPolygons()) {
-      processItem(
-          polygon,
-          polygon->getPolygon().getPath().calcNearestPointBetweenVertices(pos),
-          60, true);  // Probably large grab area makes sense?
-    }
-  }
-
-  if (flags.testFlag(FindFlag::Texts)) {
-    foreach (SI_Text* text, schematic->getTexts()) {
-      processItem(text, text->getPosition(), 70);
+      default:
+        break;
     }
   }
 
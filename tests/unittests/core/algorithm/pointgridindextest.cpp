@@ -0,0 +1,115 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/algorithm/pointgridindex.h>
+#include <librepcb/core/geometry/path.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class PointGridIndexTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(PointGridIndexTest, testEmpty) {
+  PointGridIndex index(QVector<Point>{});
+  Path area = Path::rect(Point(0, 0), Point(100, 100));
+  EXPECT_EQ(QVector<int>{}, index.findPointsInArea(area));
+}
+
+TEST_F(PointGridIndexTest, testSinglePoint) {
+  PointGridIndex index(QVector<Point>{Point(50, 50)});
+  EXPECT_EQ(QVector<int>{0},
+            index.findPointsInArea(Path::rect(Point(0, 0), Point(100, 100))));
+  EXPECT_EQ(QVector<int>{}, index.findPointsInArea(
+                                Path::rect(Point(60, 60), Point(100, 100))));
+}
+
+TEST_F(PointGridIndexTest, testPointsOnOutlineAreIncluded) {
+  PointGridIndex index(QVector<Point>{Point(0, 0), Point(0, 50)});
+  Path area = Path::rect(Point(0, 0), Point(100, 100));
+  EXPECT_EQ((QVector<int>{0, 1}), index.findPointsInArea(area));
+}
+
+TEST_F(PointGridIndexTest, testConcavePolygon) {
+  // L-shaped area, the point at (75, 75) is within its bounding box but
+  // outside of the area itself
+  Path area({
+      Vertex(Point(0, 0)),
+      Vertex(Point(100, 0)),
+      Vertex(Point(100, 50)),
+      Vertex(Point(50, 50)),
+      Vertex(Point(50, 100)),
+      Vertex(Point(0, 100)),
+      Vertex(Point(0, 0)),
+  });
+  PointGridIndex index(QVector<Point>{Point(25, 25), Point(75, 75),
+                                      Point(75, 25), Point(25, 75),
+                                      Point(200, 200)});
+  EXPECT_EQ((QVector<int>{0, 2, 3}), index.findPointsInArea(area));
+}
+
+TEST_F(PointGridIndexTest, testManyPoints) {
+  QVector<Point> points;
+  for (int x = 0; x < 50; ++x) {
+    for (int y = 0; y < 50; ++y) {
+      points.append(Point(x * 1000, y * 1000));
+    }
+  }
+  PointGridIndex index(points);
+
+  // compare with brute force
+  Path area({
+      Vertex(Point(500, 700)),
+      Vertex(Point(40300, 3100)),
+      Vertex(Point(12100, 45900)),
+      Vertex(Point(500, 700)),
+  });
+  QPainterPath painterPath = area.toQPainterPathPx();
+  QVector<int> expected;
+  for (int i = 0; i < points.count(); ++i) {
+    if (painterPath.contains(points.at(i).toPxQPointF())) {
+      expected.append(i);
+    }
+  }
+  EXPECT_EQ(expected, index.findPointsInArea(area));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -234,6 +234,35 @@ TEST_F(GerberGeneratorTest, testDoesNotContainZeroSizeApertures) {
   ASSERT_GE(checkedCircles, 3);  // Sanity check if test works.
 }
 
+// Check if streaming into a device produces exactly the same output as
+// generating into memory, and if the MD5 checksum is still correct.
+TEST_F(GerberGeneratorTest, testGenerateIntoDevice) {
+  GerberGenerator gen(
+      QDateTime(QDate(2000, 2, 1), QTime(1, 2, 3, 4), Qt::OffsetFromUTC, 3600),
+      "Project Name", Uuid::fromString("bdf7bea5-b88e-41b2-be85-c1604e8ddfca"),
+      "rev-1.0");
+  gen.drawPathOutline(Path::circle(PositiveLength(1000000)),
+                      UnsignedLength(100000), tl::nullopt, tl::nullopt, "");
+  gen.flashCircle(Point(-100, 200), PositiveLength(100000), tl::nullopt,
+                  tl::nullopt, "", "", "");
+  gen.generate();
+
+  QByteArray output;
+  QBuffer buffer(&output);
+  buffer.open(QIODevice::WriteOnly);
+  gen.generate(buffer);
+  EXPECT_EQ(gen.toStr().toStdString(), output.toStdString());
+
+  const int md5Pos = output.indexOf("G04 #@! TF.MD5,");
+  ASSERT_GT(md5Pos, 0);
+  const QByteArray md5 =
+      QCryptographicHash::hash(output.left(md5Pos).replace('\n', QByteArray()),
+                               QCryptographicHash::Md5)
+          .toHex();
+  EXPECT_EQ("G04 #@! TF.MD5," + md5.toStdString() + "*\nM02*\n",
+            output.mid(md5Pos).toStdString());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
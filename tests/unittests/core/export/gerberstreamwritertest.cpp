@@ -0,0 +1,131 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/export/gerberstreamwriter.h>
+#include <librepcb/core/utils/toolbox.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class GerberStreamWriterTest : public ::testing::Test {
+protected:
+  static QVector<qint64> values() noexcept {
+    return {
+        0,
+        1,
+        -1,
+        9,
+        10,
+        -10,
+        123456,
+        -123456,
+        999999,
+        1000000,
+        -1000000,
+        1000001,
+        12345678,
+        -12345678,
+        std::numeric_limits<qint32>::max(),
+        std::numeric_limits<qint32>::min(),
+        std::numeric_limits<qint64>::max(),
+        std::numeric_limits<qint64>::min(),
+    };
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(GerberStreamWriterTest, testAppendInteger) {
+  foreach (qint64 value, values()) {
+    QByteArray out("foo");
+    GerberStreamWriter::appendInteger(out, value);
+    EXPECT_EQ("foo" + QString::number(value).toStdString(), out.toStdString());
+  }
+}
+
+TEST_F(GerberStreamWriterTest, testAppendDecimalFixedPoint) {
+  foreach (qint64 value, values()) {
+    for (int pointPos = 1; pointPos <= 9; ++pointPos) {
+      QByteArray out("foo");
+      GerberStreamWriter::appendDecimalFixedPoint(out, value, pointPos);
+      EXPECT_EQ(
+          "foo" +
+              Toolbox::decimalFixedPointToString(value, pointPos).toStdString(),
+          out.toStdString())
+          << value << " " << pointPos;
+    }
+  }
+}
+
+TEST_F(GerberStreamWriterTest, testWrite) {
+  QByteArray large(200000, 'x');
+  QByteArray output;
+  QBuffer buffer(&output);
+  buffer.open(QIODevice::WriteOnly);
+  GerberStreamWriter writer(buffer, false);
+  writer.write("G01*\n");
+  writer.writeInteger(-42);
+  writer.write(large);
+  writer.writeDecimalFixedPoint(1500000, 6);
+  EXPECT_EQ(200008, output.size());  // Last write is still buffered.
+  writer.flush();
+  EXPECT_EQ(("G01*\n-42" + large + "1.5").toStdString(),
+            output.toStdString());
+}
+
+TEST_F(GerberStreamWriterTest, testMd5ChecksumIgnoresLineBreaks) {
+  QByteArray content = "G04 test*\nX100Y200D03*\n\nM02*\n";
+  content += QByteArray(100000, 'a') + "\n";  // Bigger than the buffer.
+  QByteArray expected = QCryptographicHash::hash(
+                            QByteArray(content).replace('\n', QByteArray()),
+                            QCryptographicHash::Md5)
+                            .toHex();
+
+  QByteArray output;
+  QBuffer buffer(&output);
+  buffer.open(QIODevice::WriteOnly);
+  GerberStreamWriter writer(buffer, true);
+  writer.write(content.left(15));
+  writer.write(content.mid(15));
+  EXPECT_EQ(expected.toStdString(), writer.getMd5Checksum().toStdString());
+  EXPECT_EQ(content.toStdString(), output.toStdString());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
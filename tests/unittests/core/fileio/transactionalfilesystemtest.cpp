@@ -137,6 +137,35 @@ TEST_F(TransactionalFileSystemTest, testWriteExistingFile) {
   EXPECT_EQ("new content", fs.read("1.txt"));
 }
 
+TEST_F(TransactionalFileSystemTest, testWriteUnmodifiedFileIsSkipped) {
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  ASSERT_EQ("1", fs.read("1.txt"));
+  ASSERT_EQ("2", fs.read("2.txt"));
+  fs.write("1.txt", "1");  // same content as on disk
+  fs.write("2.txt", "new 2");
+  fs.write("2.txt", "2");  // restore content on disk
+  EXPECT_EQ(0, fs.checkForModifications().count());
+
+  // modify files externally to detect whether they get overwritten
+  FileUtils::writeFile(mPopulatedDir.getPathTo("1.txt"), "external 1");
+  FileUtils::writeFile(mPopulatedDir.getPathTo("2.txt"), "external 2");
+  fs.save();
+  EXPECT_EQ("external 1",
+            FileUtils::readFile(mPopulatedDir.getPathTo("1.txt")));
+  EXPECT_EQ("external 2",
+            FileUtils::readFile(mPopulatedDir.getPathTo("2.txt")));
+}
+
+TEST_F(TransactionalFileSystemTest, testWriteUnmodifiedRemovedFile) {
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  ASSERT_EQ("1a", fs.read("1/1a.txt"));
+  fs.removeDirRecursively("1");
+  fs.write("1/1a.txt", "1a");  // same content, but directory gets removed
+  fs.save();
+  EXPECT_EQ("1a", FileUtils::readFile(mPopulatedDir.getPathTo("1/1a.txt")));
+  EXPECT_FALSE(mPopulatedDir.getPathTo("1/1b.txt").isExistingFile());
+}
+
 TEST_F(TransactionalFileSystemTest, testWriteCreatesNewDirectoryAndFile) {
   TransactionalFileSystem fs(mPopulatedDir, true);
   ASSERT_FALSE(fs.fileExists("x/y/z"));
@@ -442,6 +471,32 @@ TEST_F(TransactionalFileSystemTest, testAutosaveIsRemovedInDestructor) {
   EXPECT_FALSE(fp.isExistingDir());
 }
 
+TEST_F(TransactionalFileSystemTest, testAutosaveAsync) {
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.write("1.txt", "new 1");
+  QFuture<void> future = fs.autosaveAsync();
+  fs.write("2.txt", "new 2");  // not part of the autosave snapshot
+  future.waitForFinished();
+
+  // remove lock because we can't get a stale lock without crashing the app
+  FileUtils::removeFile(mPopulatedDir.getPathTo(".lock"));
+
+  // open another file system on the same directory to restore the autosave
+  TransactionalFileSystem fs2(mPopulatedDir, true,
+                              &TransactionalFileSystem::RestoreMode::yes);
+  EXPECT_TRUE(fs2.isRestoredFromAutosave());
+  EXPECT_EQ("new 1", fs2.read("1.txt"));
+  EXPECT_EQ("2", fs2.read("2.txt"));
+}
+
+TEST_F(TransactionalFileSystemTest, testAutosaveAsyncIsRemovedWhenSaving) {
+  FilePath fp = mPopulatedDir.getPathTo(".autosave");
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.autosaveAsync();
+  fs.save();  // waits for the autosave to finish
+  EXPECT_FALSE(fp.isExistingDir());
+}
+
 TEST_F(TransactionalFileSystemTest, testRestoreAutosave) {
   TransactionalFileSystem fs(mPopulatedDir, true);
 
@@ -654,6 +709,85 @@ TEST_F(TransactionalFileSystemTest, testExportZipByByteArrayWithFilter) {
   zip.close();
 }
 
+TEST_F(TransactionalFileSystemTest, testLoadFromZipOverridesDirectory) {
+  FilePath zipFp = mTmpDir.getPathTo("load.zip");
+  {
+    TransactionalFileSystem fs(mPopulatedDir, false);
+    fs.write("1.txt", "zip 1");
+    fs.write("new/new.txt", "new");
+    fs.exportToZip(zipFp);
+  }
+  TransactionalFileSystem fs(mPopulatedDir, false);
+  fs.removeDirRecursively();
+  fs.loadFromZip(zipFp);
+  EXPECT_EQ("zip 1", fs.read("1.txt"));
+  EXPECT_EQ("new", fs.read("new/new.txt"));
+  EXPECT_TRUE(fs.fileExists("1/1a.txt"));
+  EXPECT_FALSE(fs.fileExists(".dot/file.txt"));  // not exported
+  EXPECT_TRUE(fs.getDirs().contains("new"));
+  EXPECT_TRUE(fs.getFiles("new").contains("new.txt"));
+}
+
+TEST_F(TransactionalFileSystemTest, testModifyAndSaveAfterLoadFromZip) {
+  FilePath zipFp = mTmpDir.getPathTo("load.zip");
+  {
+    TransactionalFileSystem fs(mPopulatedDir, false);
+    fs.write("1.txt", "zip 1");
+    fs.write("new/new.txt", "new");
+    fs.exportToZip(zipFp);
+  }
+  TransactionalFileSystem fs(mEmptyDir, true);
+  fs.loadFromZip(zipFp);
+  fs.removeFile("2.txt");
+  fs.removeDirRecursively("a");
+  fs.write("1/1a.txt", "modified");
+  EXPECT_FALSE(fs.fileExists("2.txt"));
+  EXPECT_FALSE(fs.fileExists("a/b/c"));
+  EXPECT_EQ("modified", fs.read("1/1a.txt"));
+
+  fs.save();
+  EXPECT_EQ("zip 1", FileUtils::readFile(mEmptyDir.getPathTo("1.txt")));
+  EXPECT_EQ("new", FileUtils::readFile(mEmptyDir.getPathTo("new/new.txt")));
+  EXPECT_EQ("modified", FileUtils::readFile(mEmptyDir.getPathTo("1/1a.txt")));
+  EXPECT_EQ("1b", FileUtils::readFile(mEmptyDir.getPathTo("1/1b.txt")));
+  EXPECT_FALSE(mEmptyDir.getPathTo("2.txt").isExistingFile());
+  EXPECT_FALSE(mEmptyDir.getPathTo("a").isExistingDir());
+}
+
+TEST_F(TransactionalFileSystemTest, testExportOverLoadedZip) {
+  FilePath zipFp = mTmpDir.getPathTo("load.zip");
+  {
+    TransactionalFileSystem fs(mPopulatedDir, false);
+    fs.exportToZip(zipFp);
+  }
+  {
+    TransactionalFileSystem fs(mEmptyDir, true);
+    fs.loadFromZip(zipFp);
+    fs.write("1.txt", "modified");
+    fs.exportToZip(zipFp);
+    EXPECT_EQ("bar", fs.read("foo dir/bar dir.txt"));
+  }
+  TransactionalFileSystem fs(mEmptyDir, false);
+  fs.loadFromZip(zipFp);
+  EXPECT_EQ("modified", fs.read("1.txt"));
+  EXPECT_EQ("bar", fs.read("foo dir/bar dir.txt"));
+  EXPECT_EQ("1b", fs.read("1/1b.txt"));
+}
+
+TEST_F(TransactionalFileSystemTest, testDiscardChangesAfterLoadFromZip) {
+  QByteArray content;
+  {
+    TransactionalFileSystem fs(mPopulatedDir, false);
+    content = fs.exportToZip();
+  }
+  TransactionalFileSystem fs(mEmptyDir, true);
+  fs.loadFromZip(content);
+  EXPECT_TRUE(fs.checkForModifications().contains("foo dir/bar dir.txt"));
+  fs.discardChanges();
+  EXPECT_FALSE(fs.fileExists("foo dir/bar dir.txt"));
+  EXPECT_TRUE(fs.checkForModifications().isEmpty());
+}
+
 TEST_F(TransactionalFileSystemTest, testDiscardChanges) {
   TransactionalFileSystem fs(mPopulatedDir, true);
 
@@ -0,0 +1,110 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/fileio/ziparchive.h>
+
+#include <quazip/quazip.h>
+#include <quazip/quazipfile.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ZipArchiveTest : public ::testing::Test {
+protected:
+  FilePath mTmpDir;
+  QByteArray mZipContent;
+
+  ZipArchiveTest() {
+    mTmpDir = FilePath::getRandomTempPath();
+    FileUtils::makePath(mTmpDir);
+
+    QBuffer buffer;
+    QuaZip zip(&buffer);
+    zip.open(QuaZip::mdCreate);
+    QuaZipFile file(&zip);
+    file.open(QIODevice::WriteOnly, QuaZipNewInfo("dir/"));
+    file.close();
+    file.open(QIODevice::WriteOnly, QuaZipNewInfo("1.txt"));
+    file.write("1");
+    file.close();
+    file.open(QIODevice::WriteOnly, QuaZipNewInfo("dir/2.txt"));
+    file.write(QByteArray(100000, '2'));
+    file.close();
+    zip.close();
+    mZipContent = buffer.buffer();
+  }
+
+  virtual ~ZipArchiveTest() { QDir(mTmpDir.toStr()).removeRecursively(); }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ZipArchiveTest, testInvalidContent) {
+  EXPECT_THROW(ZipArchive archive(QByteArray("foo")), Exception);
+}
+
+TEST_F(ZipArchiveTest, testNonExistingFile) {
+  EXPECT_THROW(ZipArchive archive(mTmpDir.getPathTo("foo.zip")), Exception);
+}
+
+TEST_F(ZipArchiveTest, testGetFiles) {
+  ZipArchive archive(mZipContent);
+  QStringList files = archive.getFiles();
+  files.sort();
+  EXPECT_EQ("1.txt,dir/2.txt", files.join(",").toStdString());
+  EXPECT_TRUE(archive.contains("dir/2.txt"));
+  EXPECT_FALSE(archive.contains("dir"));
+}
+
+TEST_F(ZipArchiveTest, testReadFromByteArray) {
+  ZipArchive archive(mZipContent);
+  EXPECT_EQ(QByteArray(100000, '2'), archive.read("dir/2.txt"));
+  EXPECT_EQ(QByteArray("1"), archive.read("1.txt"));
+  EXPECT_THROW(archive.read("3.txt"), Exception);
+}
+
+TEST_F(ZipArchiveTest, testReadFromFile) {
+  FilePath fp = mTmpDir.getPathTo("archive.zip");
+  FileUtils::writeFile(fp, mZipContent);
+  ZipArchive archive(fp);
+  EXPECT_EQ(QByteArray("1"), archive.read("1.txt"));
+  EXPECT_EQ(QByteArray(100000, '2'), archive.read("dir/2.txt"));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
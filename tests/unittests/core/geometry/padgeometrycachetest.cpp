@@ -0,0 +1,89 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/geometry/padgeometrycache.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class PadGeometryCacheTest : public ::testing::Test {
+protected:
+  PadGeometryCacheTest() { PadGeometryCache::instance().clear(); }
+  virtual ~PadGeometryCacheTest() { PadGeometryCache::instance().clear(); }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(PadGeometryCacheTest, testPathsAreShared) {
+  PadGeometryCache& cache = PadGeometryCache::instance();
+  const PadGeometry geometry1 = PadGeometry::roundedRect(
+      PositiveLength(500000), PositiveLength(600000),
+      UnsignedLimitedRatio(Ratio::percent50()), HoleList());
+  const PadGeometry geometry2 = PadGeometry::roundedRect(
+      PositiveLength(500000), PositiveLength(600000),
+      UnsignedLimitedRatio(Ratio::percent50()), HoleList());
+  const PadGeometry geometry3 = geometry1.withOffset(Length(100000));
+
+  const QPainterPath path1 = cache.getQPainterPathPx(geometry1);
+  EXPECT_EQ(geometry1.toQPainterPathPx(), path1);
+  EXPECT_EQ(1, cache.count());
+  const QPainterPath path2 = cache.getQPainterPathPx(geometry2);
+  EXPECT_EQ(1, cache.count());
+  EXPECT_EQ(path1, path2);
+  const QPainterPath path3 = cache.getQPainterPathPx(geometry3);
+  EXPECT_EQ(2, cache.count());
+  EXPECT_EQ(geometry3.toQPainterPathPx(), path3);
+  EXPECT_NE(path1, path3);
+}
+
+TEST_F(PadGeometryCacheTest, testFilledPathsAreCachedSeparately) {
+  PadGeometryCache& cache = PadGeometryCache::instance();
+  const PadGeometry geometry = PadGeometry::roundedRect(
+      PositiveLength(1000000), PositiveLength(1000000),
+      UnsignedLimitedRatio(Ratio::percent0()),
+      HoleList{std::make_shared<Hole>(Uuid::createRandom(),
+                                      PositiveLength(300000),
+                                      makeNonEmptyPath(Point(0, 0)))});
+  EXPECT_EQ(geometry.toQPainterPathPx(), cache.getQPainterPathPx(geometry));
+  EXPECT_EQ(geometry.toFilledQPainterPathPx(),
+            cache.getFilledQPainterPathPx(geometry));
+  EXPECT_EQ(2, cache.count());
+  cache.clear();
+  EXPECT_EQ(0, cache.count());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,84 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/graphics/graphicsscene.h>
+
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class GraphicsSceneTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(GraphicsSceneTest, testGetItemOwnersInRect) {
+  QObject owner1, owner2, owner3;
+  QGraphicsRectItem item1(0, 0, 10, 10);
+  QGraphicsRectItem item2(20, 0, 10, 10);
+  QGraphicsRectItem child(0, 20, 10, 10, &item2);
+  QGraphicsRectItem item3(40, 0, 10, 10);
+  GraphicsScene scene;
+  scene.addItem(item1, &owner1);
+  scene.addItem(item2, &owner2);
+  scene.addItem(item3);  // without owner
+  EXPECT_EQ(QSet<QObject*>({&owner1}),
+            scene.getItemOwnersInRect(QRectF(5, 5, 1, 1)));
+  EXPECT_EQ(QSet<QObject*>({&owner2}),  // via child item
+            scene.getItemOwnersInRect(QRectF(25, 25, 1, 1)));
+  EXPECT_EQ(QSet<QObject*>({&owner1, &owner2}),
+            scene.getItemOwnersInRect(QRectF(0, 0, 50, 50)));
+  EXPECT_EQ(QSet<QObject*>(), scene.getItemOwnersInRect(QRectF(0, 50, 5, 5)));
+
+  // moved items
+  item1.setPos(0, 50);
+  EXPECT_EQ(QSet<QObject*>({&owner1}),
+            scene.getItemOwnersInRect(QRectF(0, 50, 5, 5)));
+
+  // removed items
+  scene.removeItem(item1);
+  scene.removeItem(item2);
+  scene.removeItem(item3);
+  scene.addItem(item3, &owner3);
+  EXPECT_EQ(QSet<QObject*>({&owner3}),
+            scene.getItemOwnersInRect(QRectF(0, 0, 100, 100)));
+  scene.removeItem(item3);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
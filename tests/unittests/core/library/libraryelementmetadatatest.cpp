@@ -0,0 +1,122 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/library/dev/device.h>
+#include <librepcb/core/library/libraryelementmetadata.h>
+#include <librepcb/core/library/pkg/package.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class LibraryElementMetadataTest : public ::testing::Test {
+protected:
+  FilePath mTempDir;
+  std::shared_ptr<TransactionalFileSystem> mFileSystem;
+
+  LibraryElementMetadataTest() {
+    mTempDir = FilePath::getRandomTempPath();
+    mFileSystem = TransactionalFileSystem::openRW(mTempDir);
+  }
+
+  virtual ~LibraryElementMetadataTest() {
+    mFileSystem.reset();
+    QDir(mTempDir.toStr()).removeRecursively();
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(LibraryElementMetadataTest, testOpenPackage) {
+  Package pkg(Uuid::createRandom(), Version::fromString("1.2"), "author",
+              ElementName("Foo"), "Description", "Keywords");
+  LocalizedNameMap names = pkg.getNames();
+  names.insert("de_DE", ElementName("Bar"));
+  pkg.setNames(names);
+  pkg.setDeprecated(true);
+  pkg.setCategories({Uuid::createRandom(), Uuid::createRandom()});
+  pkg.getFootprints().append(std::make_shared<Footprint>(
+      Uuid::createRandom(), ElementName("Footprint"), "Footprint"));
+  TransactionalDirectory root(mFileSystem);
+  pkg.saveIntoParentDirectory(root);
+
+  TransactionalDirectory dir(mFileSystem, pkg.getUuid().toStr());
+  const LibraryElementMetadata metadata =
+      LibraryElementMetadata::open<Package>(dir);
+  EXPECT_EQ(mTempDir.getPathTo(pkg.getUuid().toStr()),
+            metadata.getDirectory());
+  EXPECT_EQ(pkg.getUuid(), metadata.getUuid());
+  EXPECT_EQ(pkg.getVersion(), metadata.getVersion());
+  EXPECT_TRUE(metadata.isDeprecated());
+  EXPECT_EQ(pkg.getNames(), metadata.getNames());
+  EXPECT_EQ(pkg.getDescriptions(), metadata.getDescriptions());
+  EXPECT_EQ(pkg.getKeywords(), metadata.getKeywords());
+  EXPECT_EQ(pkg.getAllAvailableLocales(), metadata.getAllAvailableLocales());
+  EXPECT_EQ(pkg.getCategories(), metadata.getCategories());
+  EXPECT_FALSE(metadata.getParentUuid().has_value());
+  EXPECT_FALSE(metadata.getComponentUuid().has_value());
+  EXPECT_FALSE(metadata.getPackageUuid().has_value());
+}
+
+TEST_F(LibraryElementMetadataTest, testOpenDevice) {
+  const Uuid cmpUuid = Uuid::createRandom();
+  const Uuid pkgUuid = Uuid::createRandom();
+  Device dev(Uuid::createRandom(), Version::fromString("1.0"), "author",
+             ElementName("Foo"), "", "", cmpUuid, pkgUuid);
+  TransactionalDirectory root(mFileSystem);
+  dev.saveIntoParentDirectory(root);
+
+  TransactionalDirectory dir(mFileSystem, dev.getUuid().toStr());
+  const LibraryElementMetadata metadata =
+      LibraryElementMetadata::open<Device>(dir);
+  EXPECT_EQ(dev.getUuid(), metadata.getUuid());
+  EXPECT_FALSE(metadata.isDeprecated());
+  EXPECT_EQ(cmpUuid, metadata.getComponentUuid());
+  EXPECT_EQ(pkgUuid, metadata.getPackageUuid());
+}
+
+TEST_F(LibraryElementMetadataTest, testOpenWithDirectoryNameMismatch) {
+  Package pkg(Uuid::createRandom(), Version::fromString("1.0"), "author",
+              ElementName("Foo"), "", "");
+  TransactionalDirectory dir(mFileSystem, "foo");
+  pkg.saveTo(dir);
+  EXPECT_THROW(LibraryElementMetadata::open<Package>(dir), RuntimeError);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,90 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/drc/boarddesignrulecheck.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectloader.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardDesignRuleCheckTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardDesignRuleCheckTest, testCacheReusedOnEveryRun) {
+  // open project from test data directory
+  FilePath projectFp(TEST_DATA_DIR "/projects/Nested Planes/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  ProjectLoader loader;
+  std::unique_ptr<Project> project =
+      loader.open(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename());  // can throw
+  Board* board = project->getBoards().first();
+
+  // run the DRC three times on the unchanged board with the same cache
+  auto cache = std::make_shared<BoardDesignRuleCheck::Cache>();
+  QVector<int> reusedAreas;
+  QVector<QStringList> messages;
+  for (int i = 0; i < 3; ++i) {
+    BoardDesignRuleCheck drc(*board, BoardDesignRuleCheck::Options());
+    drc.setCache(cache);
+    drc.execute();  // can throw
+    reusedAreas.append(cache->getReusedAreaCount());
+    QStringList msgs;
+    foreach (const BoardDesignRuleCheckMessage& msg, drc.getMessages()) {
+      msgs.append(msg.getMessage());
+    }
+    msgs.sort();
+    messages.append(msgs);
+  }
+
+  // nothing cached on the first run, but all areas reused on later runs
+  EXPECT_EQ(0, reusedAreas[0]);
+  EXPECT_GT(reusedAreas[1], 0);
+  EXPECT_EQ(reusedAreas[1], reusedAreas[2]);
+  EXPECT_EQ(messages[0], messages[1]);
+  EXPECT_EQ(messages[0], messages[2]);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -107,6 +107,64 @@ TEST(BoardPlaneFragmentsBuilderTest, testFragments) {
   EXPECT_EQ(expected.toStdString(), actual.toStdString());
 }
 
+TEST(BoardPlaneFragmentsBuilderTest, testRebuildAffectedPlanes) {
+  // open project from test data directory
+  FilePath projectFp(TEST_DATA_DIR "/projects/Nested Planes/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  ProjectLoader loader;
+  std::unique_ptr<Project> project =
+      loader.open(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename());  // can throw
+  Board* board = project->getBoards().first();
+  board->rebuildAllPlanes();
+  auto getFragments = [board]() {
+    QMap<Uuid, QVector<Path>> fragments;
+    foreach (const BI_Plane* plane, board->getPlanes()) {
+      fragments.insert(plane->getUuid(), plane->getFragments());
+    }
+    return fragments;
+  };
+
+  // move a plane and rebuild only the affected planes
+  BI_Plane* plane = board->getPlanes().first();
+  const Path oldOutline = plane->getOutline();
+  const Path newOutline = oldOutline.translated(Point(1000000, 500000));
+  plane->setOutline(newOutline);
+  board->rebuildPlanes({oldOutline, newOutline});
+  const QMap<Uuid, QVector<Path>> actual = getFragments();
+
+  // the result must be the same as when rebuilding all planes
+  board->rebuildAllPlanes();
+  EXPECT_TRUE(actual == getFragments());
+}
+
+TEST(BoardPlaneFragmentsBuilderTest, testPlanesInputHash) {
+  // open project from test data directory
+  FilePath projectFp(TEST_DATA_DIR "/projects/Nested Planes/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  ProjectLoader loader;
+  std::unique_ptr<Project> project =
+      loader.open(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename());  // can throw
+  Board* board = project->getBoards().first();
+
+  // the hash must be reproducible
+  const QByteArray hash = board->calculatePlanesInputHash();
+  EXPECT_FALSE(hash.isEmpty());
+  EXPECT_EQ(hash.toStdString(),
+            board->calculatePlanesInputHash().toStdString());
+
+  // the hash must change when a plane input changes
+  BI_Plane* plane = board->getPlanes().first();
+  plane->setMinClearance(UnsignedLength(*plane->getMinClearance() + 1));
+  EXPECT_NE(hash.toStdString(),
+            board->calculatePlanesInputHash().toStdString());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -100,6 +100,36 @@ TEST(SExpressionTest, testParseStringWithBackslash) {
   EXPECT_EQ("foo\\bar", s.getChild("@0").getValue());
 }
 
+TEST(SExpressionTest, testParseStringWithLegacyEscapeSequences) {
+  SExpression s = SExpression::parse("(test \"\\'\\?\\a\")", FilePath());
+  EXPECT_EQ("'?\a", s.getChild("@0").getValue());
+}
+
+TEST(SExpressionTest, testParseStringWithIllegalEscapeSequence) {
+  EXPECT_THROW(SExpression::parse("(test \"foo\\xbar\")", FilePath()),
+               RuntimeError);
+}
+
+TEST(SExpressionTest, testParseUtf8String) {
+  SExpression s = SExpression::parse(
+      QString("(test \"\u00C4\u00F6 \\\"\u2126\\\"\")").toUtf8(), FilePath());
+  EXPECT_EQ(QString("\u00C4\u00F6 \"\u2126\"").toStdString(),
+            s.getChild("@0").getValue().toStdString());
+}
+
+TEST(SExpressionTest, testParseInvalidTokenCharacter) {
+  EXPECT_THROW(
+      SExpression::parse(QString("(test \u00C4)").toUtf8(), FilePath()),
+      RuntimeError);
+}
+
+TEST(SExpressionTest, testParsedNodesKnowFilePath) {
+  const FilePath fp = FilePath::getApplicationTempPath().getPathTo("foo.lp");
+  SExpression s = SExpression::parse("(test (child 1))", fp);
+  EXPECT_EQ(fp, s.getFilePath());
+  EXPECT_EQ(fp, s.getChild("child/@0").getFilePath());
+}
+
 TEST(SExpressionTest, testParseExpressionWithChildrenAndComments) {
   QByteArray input =
       "; (This whole line is a comment with CRLF line ending)\r\n"
@@ -150,11 +180,49 @@ TEST(SExpressionTest, testParsePartialExpression) {
   }
 }
 
+TEST(SExpressionTest, testParseOnlySomeChildren) {
+  QByteArray input =
+      "(librepcb_package 71762d7e-e7f1-403c-8020-db9670c01e9b\n"
+      " (name \"Foo\")\n"
+      " (footprint (name \"Bar\") ; comment with ( and \"\n"
+      "  (text \"string with ) and \\\" and (\")\n"
+      " )\n"
+      " (category 03f85d8b-7c14-4f4e-a8a2-c0b0c5ef4d54)\n"
+      ")\n";
+  SExpression s =
+      SExpression::parse(input, FilePath(), {"name", "category", "foo"});
+  EXPECT_EQ("71762d7e-e7f1-403c-8020-db9670c01e9b",
+            s.getChild("@0").getValue());
+  EXPECT_EQ("Foo", s.getChild("name/@0").getValue());
+  EXPECT_EQ("03f85d8b-7c14-4f4e-a8a2-c0b0c5ef4d54",
+            s.getChild("category/@0").getValue());
+  EXPECT_EQ(nullptr, s.tryGetChild("footprint"));
+}
+
+TEST(SExpressionTest, testParseOnlySomeChildrenWithUnclosedSkippedChild) {
+  EXPECT_THROW(
+      SExpression::parse("(test (foo) (bar \")\"", FilePath(), {"foo"}),
+      RuntimeError);
+}
+
 TEST(SExpressionTest, testSerializeStringWithEscaping) {
   SExpression s = SExpression::createString("Foo\n \r\n \" \\ Bar");
   EXPECT_EQ("\"Foo\\n \\r\\n \\\" \\\\ Bar\"\n", s.toByteArray());
 }
 
+TEST(SExpressionTest, testSerializeUtf8String) {
+  SExpression s = SExpression::createList("test");
+  s.appendChild(SExpression::createString(QString("\u00C4 \"\u2126\"\t")));
+  EXPECT_EQ(QString("(test \"\u00C4 \\\"\u2126\\\"\\t\")\n").toUtf8(),
+            s.toByteArray());
+}
+
+TEST(SExpressionTest, testSerializeInvalidToken) {
+  SExpression s = SExpression::createList("test");
+  s.appendChild(SExpression::createToken("foo bar"));
+  EXPECT_THROW(s.toByteArray(), LogicError);
+}
+
 TEST(SExpressionTest, testRoundtrip) {
   // Create input with wrong indentation, this shall be fixed by toByteArray().
   QByteArray input =
@@ -216,6 +284,22 @@ TEST(SExpressionTest, testGetChildSkipsLineBreaks) {
   EXPECT_EQ("2", s.getChild("child/@2").getValue().toStdString());
 }
 
+TEST(SExpressionTest, testTryGetChild) {
+  const SExpression s =
+      SExpression::parse("(root (a (b 1 2) (b 3)) (c))", FilePath());
+  EXPECT_EQ(nullptr, s.tryGetChild(QString()));
+  EXPECT_EQ("2", s.getChild("a/b/@1").getValue().toStdString());
+  EXPECT_EQ("b", s.getChild("a/@1").getName().toStdString());
+  EXPECT_EQ("c", s.getChild("c").getName().toStdString());
+  EXPECT_EQ(nullptr, s.tryGetChild("a/"));
+  EXPECT_EQ(nullptr, s.tryGetChild("/a"));
+  EXPECT_EQ(nullptr, s.tryGetChild("a//b"));
+  EXPECT_EQ(nullptr, s.tryGetChild("a/b/@2"));
+  EXPECT_EQ(nullptr, s.tryGetChild("a/b/@-1"));
+  EXPECT_EQ(nullptr, s.tryGetChild("a/b/@x"));
+  EXPECT_EQ(nullptr, s.tryGetChild("d"));
+}
+
 TEST(SExpressionTest, testRemoveChild) {
   const QByteArray input =
       "(test value\n"
@@ -145,6 +145,21 @@ TEST_P(UuidTest, testOperatorComparisons) {
   }
 }
 
+TEST_P(UuidTest, testHash) {
+  const UuidTestData& data = GetParam();
+
+  if (data.valid) {
+    Uuid uuid1 = Uuid::fromString(data.uuid);
+    Uuid uuid2 = Uuid::fromString(data.uuid);
+    EXPECT_EQ(qHash(uuid1, 0), qHash(uuid2, 0));
+    EXPECT_EQ(qHash(uuid1, 42), qHash(uuid2, 42));
+    QSet<Uuid> set{uuid1};
+    EXPECT_TRUE(set.contains(uuid2));
+    EXPECT_FALSE(set.contains(
+        Uuid::fromString("d2c30518-5cd1-4ce9-a569-44f783a3f66b")));
+  }
+}
+
 TEST(UuidTest, testCreateRandom) {
   for (int i = 0; i < 1000; i++) {
     Uuid uuid = Uuid::createRandom();
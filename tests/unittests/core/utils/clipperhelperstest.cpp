@@ -59,6 +59,41 @@ TEST_F(ClipperHelpersTest, testConvertPathWithApproximate) {
       outputStr.toStdString());
 }
 
+TEST_F(ClipperHelpersTest, testGetBounds) {
+  ClipperLib::Paths paths = {
+      {{10, 20}, {30, -5}, {15, 40}},
+      {{-10, 0}, {5, 5}},
+  };
+  ClipperLib::IntRect rect = ClipperHelpers::getBounds(paths);
+  EXPECT_EQ(-10, rect.left);
+  EXPECT_EQ(-5, rect.top);
+  EXPECT_EQ(30, rect.right);
+  EXPECT_EQ(40, rect.bottom);
+}
+
+TEST_F(ClipperHelpersTest, testGetBoundsOfEmptyPaths) {
+  ClipperLib::IntRect rect = ClipperHelpers::getBounds(ClipperLib::Paths());
+  EXPECT_GT(rect.left, rect.right);
+  EXPECT_FALSE(ClipperHelpers::overlaps(rect, rect));
+}
+
+TEST_F(ClipperHelpersTest, testFindOverlappingBounds) {
+  QVector<ClipperLib::IntRect> bounds = {
+      {0, 0, 10, 10},  // overlaps with 2, 3
+      {100, 100, 110, 110},  // overlaps with nothing
+      {5, 5, 20, 20},  // overlaps with 0, 3
+      {10, -50, 12, 5},  // overlaps (touches) with 0, 2
+      ClipperHelpers::getBounds(ClipperLib::Paths()),  // empty
+  };
+  QVector<QVector<int>> result = ClipperHelpers::findOverlappingBounds(bounds);
+  ASSERT_EQ(5, result.count());
+  EXPECT_EQ(QVector<int>({2, 3}), result.at(0));
+  EXPECT_EQ(QVector<int>(), result.at(1));
+  EXPECT_EQ(QVector<int>({3}), result.at(2));
+  EXPECT_EQ(QVector<int>(), result.at(3));
+  EXPECT_EQ(QVector<int>(), result.at(4));
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
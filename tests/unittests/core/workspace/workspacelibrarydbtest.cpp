@@ -403,6 +403,54 @@ TEST_F(WorkspaceLibraryDbTest, testFindWithMultipleTranslations) {
             str(mWsDb->find<Symbol>("sym1 en_US name")));
 }
 
+TEST_F(WorkspaceLibraryDbTest, testFindWordPrefixes) {
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("1"), false,
+                                QByteArray());
+  int sym = mWriter->addElement<Symbol>(lib, toAbs("sym1"), uuid(1),
+                                        version("0.1"), false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("SMD Resistor 0805"),
+                                  "", "chip,r");
+  sym = mWriter->addElement<Symbol>(lib, toAbs("sym2"), uuid(2), version("0.2"),
+                                    false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("THT Resistor"), "",
+                                  "");
+
+  EXPECT_EQ(str(QList<Uuid>{uuid(1), uuid(2)}),
+            str(mWsDb->find<Symbol>("resis")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(1)}), str(mWsDb->find<Symbol>("res 08")));
+  EXPECT_EQ(str(QList<Uuid>{uuid(1)}), str(mWsDb->find<Symbol>("CHIP-RES")));
+  EXPECT_EQ(str(QList<Uuid>{}), str(mWsDb->find<Symbol>("res 06")));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testFindSortedByRelevance) {
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("1"), false,
+                                QByteArray());
+  int sym = mWriter->addElement<Symbol>(lib, toAbs("sym1"), uuid(1),
+                                        version("0.1"), false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("alpha"), "", "foo");
+  sym = mWriter->addElement<Symbol>(lib, toAbs("sym2"), uuid(2), version("0.2"),
+                                    false);
+  mWriter->addTranslation<Symbol>(sym, "", ElementName("foo"), "", "");
+
+  // Matches in names are more relevant than matches in keywords.
+  EXPECT_EQ(str(QList<Uuid>{uuid(2), uuid(1)}),
+            str(mWsDb->find<Symbol>("foo")));
+}
+
+TEST_F(WorkspaceLibraryDbTest, testFindWithLimit) {
+  int lib = mWriter->addLibrary(toAbs("lib"), uuid(), version("1"), false,
+                                QByteArray());
+  for (int i = 1; i <= 3; ++i) {
+    int sym = mWriter->addElement<Symbol>(lib, toAbs(QString("sym%1").arg(i)),
+                                          uuid(i), version("0.1"), false);
+    mWriter->addTranslation<Symbol>(
+        sym, "", ElementName(QString("the sym%1 name").arg(i)), "", "");
+  }
+
+  EXPECT_EQ(str(QList<Uuid>{uuid(1), uuid(2)}),
+            str(mWsDb->find<Symbol>("name", 2)));
+}
+
 /*******************************************************************************
  *  Tests for getTranslations()
  ******************************************************************************/